@@ -0,0 +1,330 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "zll.hpp"
+#include "zll_parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Simple xorshift generator, benchmarks should be reproducible and independent of std::random
+/// implementation.
+struct rng
+{
+        std::uint64_t s = 0x9E3779B97F4A7C15ULL;
+
+        std::uint64_t operator()() noexcept
+        {
+                s ^= s << 13;
+                s ^= s >> 7;
+                s ^= s << 17;
+                return s;
+        }
+};
+
+/// Prints throughput and latency percentiles of per-operation samples in nanoseconds.
+void report( std::string_view name, std::vector< std::uint64_t >& samples )
+{
+        if ( samples.empty() )
+                return;
+        std::sort( samples.begin(), samples.end() );
+        auto pct = [&]( double p ) {
+                auto last = static_cast< double >( samples.size() - 1 );
+                return samples[static_cast< std::size_t >( p * last )];
+        };
+        std::uint64_t sum = 0;
+        for ( auto s : samples )
+                sum += s;
+        std::printf(
+            "%-32.*s %10zu ops %8.1f ns/op  p50 %6llu  p99 %6llu  p99.9 %7llu  p99.99 %8llu  max "
+            "%9llu\n",
+            static_cast< int >( name.size() ),
+            name.data(),
+            samples.size(),
+            static_cast< double >( sum ) / static_cast< double >( samples.size() ),
+            static_cast< unsigned long long >( pct( 0.5 ) ),
+            static_cast< unsigned long long >( pct( 0.99 ) ),
+            static_cast< unsigned long long >( pct( 0.999 ) ),
+            static_cast< unsigned long long >( pct( 0.9999 ) ),
+            static_cast< unsigned long long >( samples.back() ) );
+}
+
+/// Prints duration of single run over `n` nodes.
+void report_run( std::string_view name, std::size_t n, std::uint64_t ns )
+{
+        std::printf(
+            "%-32.*s %10zu nodes %8.1f ms  %6.1f ns/node\n",
+            static_cast< int >( name.size() ),
+            name.data(),
+            n,
+            static_cast< double >( ns ) / 1e6,
+            static_cast< double >( ns ) / static_cast< double >( n ) );
+}
+
+/// Runs `f` and returns its duration in nanoseconds.
+template < typename F >
+std::uint64_t timed( F&& f )
+{
+        auto s = bench_clock::now();
+        f();
+        auto e = bench_clock::now();
+        return static_cast< std::uint64_t >(
+            std::chrono::duration_cast< std::chrono::nanoseconds >( e - s ).count() );
+}
+
+struct sh_timer : zll::sh_base< sh_timer >
+{
+        std::uint64_t deadline = 0;
+
+        bool operator<( sh_timer const& o ) const noexcept
+        {
+                return deadline < o.deadline;
+        }
+};
+
+struct lh_timer : zll::lh_base< lh_timer >
+{
+        std::uint64_t deadline = 0;
+
+        bool operator<( lh_timer const& o ) const noexcept
+        {
+                return deadline < o.deadline;
+        }
+};
+
+/// Classic "hold" model of timer queue: take the earliest timer and re-arm it with later deadline.
+template < typename Heap, typename Node >
+void bench_heap_hold( std::string_view name, std::size_t n, std::size_t ops )
+{
+        std::vector< Node > nodes( n );
+        Heap                h;
+        rng                 r;
+        for ( auto& t : nodes ) {
+                t.deadline = r() % ( n * 16 );
+                h.link( t );
+        }
+
+        std::vector< std::uint64_t > samples;
+        samples.reserve( ops );
+        for ( std::size_t i = 0; i < ops; i++ ) {
+                std::uint64_t delta = r() % ( n * 16 );
+                samples.push_back( timed( [&] {
+                        Node& t = h.take();
+                        t.deadline += delta;
+                        h.link( t );
+                } ) );
+        }
+        report( name, samples );
+}
+
+/// Links nodes with ascending deadlines and pops them all, which builds long spines for heaps
+/// without worst-case guarantees.
+template < typename Heap, typename Node >
+void bench_heap_ascending( std::string_view name, std::size_t n )
+{
+        std::vector< Node > nodes( n );
+        Heap                h;
+
+        std::vector< std::uint64_t > samples;
+        samples.reserve( 2 * n );
+        std::uint64_t d = 0;
+        for ( auto& t : nodes ) {
+                t.deadline = d++;
+                samples.push_back( timed( [&] {
+                        h.link( t );
+                } ) );
+        }
+        while ( !h.empty() )
+                samples.push_back( timed( [&] {
+                        h.take();
+                } ) );
+        report( name, samples );
+}
+
+struct ll_item : zll::ll_base< ll_item >
+{
+        std::uint64_t value = 0;
+
+        bool operator<( ll_item const& o ) const noexcept
+        {
+                return value < o.value;
+        }
+};
+
+/// Runs `f` on list of `n` nodes with random values.
+template < typename F >
+void bench_list( std::string_view name, std::size_t n, F&& f )
+{
+        std::vector< ll_item >   nodes( n );
+        zll::ll_list< ll_item > l;
+        rng                      r;
+        for ( auto& i : nodes ) {
+                i.value = r();
+                l.link_back( i );
+        }
+        report_run( name, n, timed( [&] {
+                            f( l );
+                    } ) );
+}
+
+struct ring_item : zll::ll_ring_base< ring_item >
+{
+        std::uint64_t value = 0;
+};
+
+/// LRU touch pattern: random node is unlinked and linked back to the end of the list, `ops` times.
+template < typename List, typename Node >
+void bench_list_touch( std::string_view name, std::size_t n, std::size_t ops )
+{
+        std::vector< Node > nodes( n );
+        List                l;
+        for ( auto& i : nodes )
+                l.link_back( i );
+
+        std::vector< std::uint32_t > idx( ops );
+        rng                          r;
+        for ( auto& i : idx )
+                i = static_cast< std::uint32_t >( r() % n );
+
+        auto ns = timed( [&] {
+                for ( auto i : idx ) {
+                        Node& x = nodes[i];
+                        detach( x );
+                        l.link_back( x );
+                }
+        } );
+        std::printf(
+            "%-32.*s %10zu ops   %8.1f ms  %6.2f ns/op\n",
+            static_cast< int >( name.size() ),
+            name.data(),
+            ops,
+            static_cast< double >( ns ) / 1e6,
+            static_cast< double >( ns ) / static_cast< double >( ops ) );
+}
+
+/// Task of binary fan-out tree, each task does a bit of work and submits its children.
+struct bench_task : zll::ws_task
+{
+        zll::ws_scheduler*         sched = nullptr;
+        std::vector< bench_task >* tree  = nullptr;
+        std::size_t                index = 0;
+        std::uint64_t              value = 0;
+
+        bench_task()
+          : zll::ws_task( []( zll::ws_task& t ) {
+                  auto& self = static_cast< bench_task& >( t );
+                  for ( int j = 0; j < 256; j++ )
+                          self.value = self.value * 6364136223846793005ull + 1;
+                  for ( std::size_t c : { 2 * self.index + 1, 2 * self.index + 2 } )
+                          if ( c < self.tree->size() )
+                                  self.sched->submit( ( *self.tree )[c] );
+          } )
+        {
+        }
+};
+
+/// Runs fan-out tree of `n` tasks on scheduler with `threads` workers.
+void bench_ws_fanout( std::string_view name, std::size_t n, std::size_t threads )
+{
+        zll::ws_scheduler         s{ threads };
+        std::vector< bench_task > tree( n );
+        for ( std::size_t i = 0; i < n; i++ ) {
+                tree[i].sched = &s;
+                tree[i].tree  = &tree;
+                tree[i].index = i;
+        }
+        report_run( name, n, timed( [&] {
+                            s.submit( tree[0] );
+                            s.wait_idle();
+                    } ) );
+}
+
+}  // namespace
+
+int main()
+{
+        constexpr std::size_t n   = 100'000;
+        constexpr std::size_t ops = 1'000'000;
+
+        bench_heap_hold< zll::sh_heap< sh_timer >, sh_timer >( "sh_heap hold", n, ops );
+        bench_heap_hold< zll::lh_heap< lh_timer >, lh_timer >( "lh_heap hold", n, ops );
+        bench_heap_ascending< zll::sh_heap< sh_timer >, sh_timer >( "sh_heap ascending", n );
+        bench_heap_ascending< zll::lh_heap< lh_timer >, lh_timer >( "lh_heap ascending", n );
+
+        bench_list_touch< zll::ll_list< ll_item >, ll_item >( "ll_list touch", 1024, 10'000'000 );
+        bench_list_touch< zll::ll_ring< ring_item >, ring_item >(
+            "ll_ring touch", 1024, 10'000'000 );
+
+        constexpr std::size_t sort_n = 1'000'000;
+        bench_list( "ll_list take_front loop", sort_n, []( auto& l ) {
+                while ( !l.empty() )
+                        l.take_front();
+        } );
+        bench_list( "ll_list::clear", sort_n, []( auto& l ) {
+                l.clear();
+        } );
+        bench_list( "ll_list::clear_fast", sort_n, []( auto& l ) {
+                l.clear_fast();
+        } );
+
+        bench_list( "ll_list::sort", sort_n, []( auto& l ) {
+                l.sort();
+        } );
+        for ( std::size_t t : { 1u, 2u, 4u, 8u } ) {
+                char name[64];
+                std::snprintf( name, sizeof( name ), "parallel_sort %zu threads", t );
+                bench_list( name, sort_n, [t]( auto& l ) {
+                        zll::parallel_sort( l, std::less<>{}, t );
+                } );
+        }
+
+        for ( std::size_t t : { 1u, 2u, 4u, 8u } ) {
+                char name[64];
+                std::snprintf( name, sizeof( name ), "parallel_for_each %zu threads", t );
+                bench_list( name, sort_n, [t]( auto& l ) {
+                        zll::parallel_for_each(
+                            l,
+                            []( ll_item& i ) {
+                                    for ( int j = 0; j < 64; j++ )
+                                            i.value = i.value * 6364136223846793005ull + 1;
+                            },
+                            t );
+                } );
+        }
+
+        for ( std::size_t t : { 1u, 2u, 4u, 8u } ) {
+                char name[64];
+                std::snprintf( name, sizeof( name ), "ws_scheduler fan-out %zu threads", t );
+                bench_ws_fanout( name, sort_n, t );
+        }
+
+        return 0;
+}
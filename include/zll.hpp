@@ -22,10 +22,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <bit>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #ifdef ZLL_DEFAULT_ASSERT
 
@@ -40,9 +48,88 @@
 
 #endif
 
+#ifdef ZLL_DEFAULT_INSTRUMENT
+
+#include <atomic>
+#define ZLL_INSTRUMENT( T, event, n ) ::zll::instr_counters< T >::record( event, n )
+
+#else
+
+#ifndef ZLL_INSTRUMENT
+#define ZLL_INSTRUMENT( T, event, n ) ( (void) ( n ) )
+#endif
+
+#endif
+
+#if defined( ZLL_TRACE ) && __has_include( <sys/sdt.h> )
+
+#include <sys/sdt.h>
+#define ZLL_PROBE1( name, a ) DTRACE_PROBE1( zll, name, a )
+#define ZLL_PROBE2( name, a, b ) DTRACE_PROBE2( zll, name, a, b )
+#define ZLL_PROBE3( name, a, b, c ) DTRACE_PROBE3( zll, name, a, b, c )
+
+#else
+
+#define ZLL_PROBE1( name, a ) ( (void) 0 )
+#define ZLL_PROBE2( name, a, b ) ( (void) 0 )
+#define ZLL_PROBE3( name, a, b, c ) ( (void) 0 )
+
+#endif
+
 namespace zll
 {
 
+/// Events reported through `ZLL_INSTRUMENT( T, event, n )` macro, `T` is the node type and `n` is
+/// the length of the walk for `sort_walk`, otherwise 1.
+enum class instr_event : std::uint8_t
+{
+        link,
+        detach,
+        move,
+        merge_step,
+        sort_walk,
+        iter_step,
+        _count
+};
+
+#ifdef ZLL_DEFAULT_INSTRUMENT
+
+/// Default instrumentation enabled by `ZLL_DEFAULT_INSTRUMENT`. Per node type counts of events and
+/// histograms of reported lengths, bucket `i` counts lengths in [2^(i-1), 2^i).
+template < typename T >
+struct instr_counters
+{
+        static constexpr std::size_t bucket_count = 65;
+        static constexpr std::size_t event_count =
+            static_cast< std::size_t >( instr_event::_count );
+
+        static inline std::atomic< std::uint64_t > count[event_count];
+        static inline std::atomic< std::uint64_t > hist[event_count][bucket_count];
+
+        static void record( instr_event e, std::size_t n ) noexcept
+        {
+                auto i = static_cast< std::size_t >( e );
+                count[i].fetch_add( 1, std::memory_order_relaxed );
+                hist[i][std::bit_width( n )].fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        static std::uint64_t get( instr_event e ) noexcept
+        {
+                return count[static_cast< std::size_t >( e )].load( std::memory_order_relaxed );
+        }
+
+        static void reset() noexcept
+        {
+                for ( std::size_t i = 0; i < event_count; i++ ) {
+                        count[i].store( 0, std::memory_order_relaxed );
+                        for ( auto& b : hist[i] )
+                                b.store( 0, std::memory_order_relaxed );
+                }
+        }
+};
+
+#endif
+
 template < typename T, typename Acc = typename T::access >
 struct ll_list;
 
@@ -63,16 +150,27 @@ concept _provides_ll_header = requires( T& t ) {
         } -> std::convertible_to< ll_header< std::remove_const_t< T >, Acc > const& >;
 };
 
-template < typename A, typename B >
+/// Tagged pointer to either `A` or `B`, the lowest bit of the address is set for `B`. Next `Bits`
+/// low bits are spare flags, both `A` and `B` have to be aligned enough to keep them zero in the
+/// address. Flags belong to the place where the pointer is stored: assignment replaces only the
+/// address and keeps flags of the destination, so flags stay with the header while the container
+/// relinks the node. Comparison ignores flags.
+///
+/// Null state is usable in constant expressions, so detached nodes and empty containers can be
+/// `constinit`. Converting an address to an integer is not a constant expression, hence linking is
+/// done at runtime only; `ll_ring` links plain header pointers and is fully constexpr.
+template < typename A, typename B, std::size_t Bits = 0 >
 struct _vptr
 {
-        static constexpr std::intptr_t mask = 1;
+        static constexpr std::intptr_t mask       = 1;
+        static constexpr std::intptr_t flags_mask = ( ( std::intptr_t{ 1 } << Bits ) - 1 ) << 1;
+        static constexpr std::intptr_t addr_mask  = ~( mask | flags_mask );
 
         std::intptr_t ptr = 0;
 
-        _vptr( std::nullptr_t ) noexcept
+        constexpr _vptr( std::nullptr_t ) noexcept
         {
-                ptr = std::bit_cast< std::intptr_t >( nullptr );
+                ptr = 0;
         };
 
         _vptr( A& n ) noexcept
@@ -85,34 +183,73 @@ struct _vptr
                 ptr = std::bit_cast< std::intptr_t >( &n ) | mask;
         };
 
-        operator bool() noexcept
+        constexpr _vptr( _vptr const& ) noexcept = default;
+
+// GCC false positive: when the header is not at the start of the node, it can't rule out that the
+// node pointer was computed from a tagged pointer to the list and reports reading the old flags as
+// out of bounds access of the list.
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+        constexpr _vptr& operator=( _vptr const& o ) noexcept
+        {
+                ptr = ( o.ptr & ~flags_mask ) | ( ptr & flags_mask );
+                return *this;
+        }
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+        constexpr operator bool() const noexcept
         {
-                return !!ptr;
+                return !!( ptr & addr_mask );
         }
 
-        bool is_a() const noexcept
+        constexpr bool is_a() const noexcept
         {
                 return !( ptr & mask );
         }
 
-        A* a() const noexcept
+        constexpr A* a() const noexcept
+        {
+                static_assert( alignof( A ) > ( mask | flags_mask ) );
+                return *this && is_a() ? std::bit_cast< A* >( ptr & addr_mask ) : nullptr;
+        }
+
+        constexpr B* b() const noexcept
+        {
+                static_assert( alignof( B ) > ( mask | flags_mask ) );
+                return *this && !is_a() ? std::bit_cast< B* >( ptr & addr_mask ) : nullptr;
+        }
+
+        /// Returns the spare flags.
+        constexpr std::uintptr_t flags() const noexcept
+        {
+                return static_cast< std::uintptr_t >( ( ptr & flags_mask ) >> 1 );
+        }
+
+        /// Sets the spare flags, bits above `Bits` are ignored.
+        constexpr void set_flags( std::uintptr_t f ) noexcept
         {
-                static_assert( alignof( A ) > 2 );
-                return ptr && is_a() ? std::bit_cast< A* >( ptr ) : nullptr;
+                auto v = static_cast< std::intptr_t >( f << 1 );
+                ptr    = ( ptr & ~flags_mask ) | ( v & flags_mask );
         }
 
-        B* b() const noexcept
+        friend constexpr bool operator==( _vptr const& lh, _vptr const& rh ) noexcept
         {
-                static_assert( alignof( B ) > 2 );
-                return ptr && !is_a() ? std::bit_cast< B* >( ptr & ~mask ) : nullptr;
+                return ( lh.ptr & ~flags_mask ) == ( rh.ptr & ~flags_mask );
         }
 
-        friend auto operator<=>( _vptr const& lh, _vptr const& rh ) noexcept = default;
+        friend constexpr auto operator<=>( _vptr const& lh, _vptr const& rh ) noexcept
+        {
+                return ( lh.ptr & ~flags_mask ) <=> ( rh.ptr & ~flags_mask );
+        }
 };
 
-/// Variadic ptr wrapper pointer either to ll_list or node with ll_header.
+/// Variadic ptr wrapper pointer either to ll_list or node with ll_header, with one spare flag.
 template < typename T, typename Acc >
-using _ll_ptr = _vptr< T, ll_list< T, Acc > >;
+using _ll_ptr = _vptr< T, ll_list< T, Acc >, 1 >;
 
 // GCC false positive: after inlining _node()/_list() into callers it incorrectly
 // infers a potential null dereference on the return value of _vptr::a()/b().
@@ -129,7 +266,7 @@ constexpr auto* _list( _ll_ptr< T, Acc > p ) noexcept
 }
 
 template < typename T, typename Acc >
-void _prev_or_last_set( _ll_ptr< T, Acc > p, _ll_ptr< T, Acc > n ) noexcept(
+constexpr void _prev_or_last_set( _ll_ptr< T, Acc > p, _ll_ptr< T, Acc > n ) noexcept(
     _nothrow_access< Acc, T > )
 {
         if ( T* x = _node( p ) )
@@ -139,7 +276,7 @@ void _prev_or_last_set( _ll_ptr< T, Acc > p, _ll_ptr< T, Acc > n ) noexcept(
 }
 
 template < typename T, typename Acc >
-void _next_or_first_set( _ll_ptr< T, Acc > p, _ll_ptr< T, Acc > n ) noexcept(
+constexpr void _next_or_first_set( _ll_ptr< T, Acc > p, _ll_ptr< T, Acc > n ) noexcept(
     _nothrow_access< Acc, T > )
 {
         if ( T* x = _node( p ) )
@@ -165,8 +302,10 @@ struct ll_header
         ll_header& operator=( ll_header&& other ) noexcept = delete;
         ll_header& operator=( ll_header const& other )     = delete;
 
-        ~ll_header() noexcept( _nothrow_access< Acc, T > )
+        constexpr ~ll_header() noexcept( _nothrow_access< Acc, T > )
         {
+                if ( next || prev )
+                        ZLL_PROBE1( ll_unlink, this );
                 _prev_or_last_set( next, prev );
                 _next_or_first_set( prev, next );
         }
@@ -178,6 +317,7 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void detach( T& node ) noexcept( _nothrow_access< Acc, T > )
 {
+        ZLL_INSTRUMENT( T, instr_event::detach, 1 );
         auto& n_hdr = Acc::get( node );
 
         _prev_or_last_set( n_hdr.next, n_hdr.prev );
@@ -196,6 +336,27 @@ bool detached( T& node ) noexcept( _nothrow_access< Acc, T > )
         return !n_hdr.next && !n_hdr.prev;
 }
 
+/// Returns user flags stored in spare bits of the header of `node`, two flags are available. Flags
+/// belong to the node: they are kept while the node is linked or detached and `move_from_to` does
+/// not transfer them.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ll_header< T, Acc > )
+std::uintptr_t node_flags( T const& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto& n_hdr = Acc::get( node );
+        return n_hdr.next.flags() | n_hdr.prev.flags() << 1;
+}
+
+/// Sets user flags stored in spare bits of the header of `node`, see `node_flags`.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ll_header< T, Acc > )
+void set_node_flags( T& node, std::uintptr_t f ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto& n_hdr = Acc::get( node );
+        n_hdr.next.set_flags( f );
+        n_hdr.prev.set_flags( f >> 1 );
+}
+
 /// Detaches subrange [first, last] from the list. The range is not linked to any other node after
 /// detachment. Successor of `last` and predecessor of `first` are linked together.
 template < typename T, typename Acc = typename T::access >
@@ -223,7 +384,8 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void move_from_to( T& from, T& to ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached( to ) );
+        ZLL_ASSERT( ( detached< T, Acc >( to ) ) );
+        ZLL_INSTRUMENT( T, instr_event::move, 1 );
         auto& from_hdr = Acc::get( from );
         auto& to_hdr   = Acc::get( to );
 
@@ -244,6 +406,7 @@ requires( _provides_ll_header< T, Acc > )
 void link_detached_as_next( T& n, T& d ) noexcept( _nothrow_access< Acc, T > )
 {
         ZLL_ASSERT( ( detached< T, Acc >( d ) ) );
+        ZLL_INSTRUMENT( T, instr_event::link, 1 );
         auto& e_hdr = Acc::get( d );
         auto& n_hdr = Acc::get( n );
 
@@ -260,7 +423,8 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void link_detached_as_prev( T& n, T& d ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached( d ) );
+        ZLL_ASSERT( ( detached< T, Acc >( d ) ) );
+        ZLL_INSTRUMENT( T, instr_event::link, 1 );
         auto& e_hdr = Acc::get( d );
         auto& n_hdr = Acc::get( n );
 
@@ -278,7 +442,7 @@ T& first_node_of( T& n ) noexcept( _nothrow_access< Acc, T > )
 {
         auto* p = &n;
         while ( p ) {
-                auto* pp = Acc::get( p ).prev.node();
+                auto* pp = _node( Acc::get( *p ).prev );
                 if ( !pp )
                         break;
                 p = pp;
@@ -307,8 +471,8 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void link_detached_as_last( T& n, T& d ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached( d ) );
-        T& last = last_node_of( n );
+        ZLL_ASSERT( ( detached< T, Acc >( d ) ) );
+        T& last = last_node_of< T, Acc >( n );
         link_detached_as_next< T, Acc >( last, d );
 }
 
@@ -318,8 +482,8 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void link_detached_as_first( T& n, T& d ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached( d ) );
-        T& first = first_node_of( n );
+        ZLL_ASSERT( ( detached< T, Acc >( d ) ) );
+        T& first = first_node_of< T, Acc >( n );
         link_detached_as_prev< T, Acc >( first, d );
 }
 
@@ -331,7 +495,7 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void link_range_as_next( T& n, T& first, T& last ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached_range( first, last ) );
+        ZLL_ASSERT( ( detached_range< T, Acc >( first, last ) ) );
         Acc::get( last ).next = Acc::get( n ).next;
         _prev_or_last_set< T, Acc >( Acc::get( n ).next, last );
 
@@ -347,7 +511,7 @@ template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 void link_range_as_prev( T& n, T& first, T& last ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached_range( first, last ) );
+        ZLL_ASSERT( ( detached_range< T, Acc >( first, last ) ) );
         Acc::get( first ).prev = Acc::get( n ).prev;
         _next_or_first_set< T, Acc >( Acc::get( n ).prev, first );
 
@@ -366,8 +530,8 @@ void link_group( std::initializer_list< T* > nodes )
         auto  b = nodes.begin();
         auto* n = *b++;
         for ( auto e = nodes.end(); b != e; ++b ) {
-                ZLL_ASSERT( detached( **b ) );
-                link_detached_as_next( *n, **b );
+                ZLL_ASSERT( ( detached< T, Acc >( **b ) ) );
+                link_detached_as_next< T, Acc >( *n, **b );
                 n = *b;
         }
 }
@@ -381,7 +545,7 @@ std::pair< T*, T* >
 merge_ranges( T& lhf, T& lhl, T& rhf, T& rhl, Compare&& comp = std::less<>{} ) noexcept(
     _nothrow_access< Acc, T > && noexcept( comp( lhf, rhf ) ) )
 {
-        detach_range( rhf, rhl );
+        detach_range< T, Acc >( rhf, rhl );
         T*                lh    = &lhf;
         T*                rh    = &rhf;
         T*                first = nullptr;
@@ -400,11 +564,11 @@ merge_ranges( T& lhf, T& lhl, T& rhf, T& rhl, Compare&& comp = std::less<>{} ) n
                         else
                                 lh = _node( Acc::get( *lh ).next );
                 }
-                detach( *tmp );
+                detach< T, Acc >( *tmp );
                 if ( !first )
                         first = tmp;
                 if ( last )
-                        link_detached_as_next( *last, *tmp );
+                        link_detached_as_next< T, Acc >( *last, *tmp );
                 last = tmp;
         }
         ZLL_ASSERT( first );
@@ -441,7 +605,7 @@ std::size_t range_remove( T& first, T& last, Pred&& p ) noexcept(
         for ( ;; ) {
                 T* tmp = _node( Acc::get( *n ).next );
                 if ( p( *n ) ) {
-                        detach( *n );
+                        detach< T, Acc >( *n );
                         ++count;
                 }
                 if ( n == &last )
@@ -462,8 +626,8 @@ void range_reverse( T& first, T& last ) noexcept( _nothrow_access< Acc, T > )
         while ( n != &first ) {
                 T* p = _node( Acc::get( last ).prev );
                 ZLL_ASSERT( p != nullptr );
-                detach( *p );
-                link_detached_as_next( *n, *p );
+                detach< T, Acc >( *p );
+                link_detached_as_next< T, Acc >( *n, *p );
                 n = p;
         }
 }
@@ -482,7 +646,7 @@ std::size_t range_unique( T& first, T& last, BinPred&& p = std::equal_to<>{} ) n
                 if ( !n )
                         break;
                 if ( p( *m, *n ) ) {
-                        detach( *n );
+                        detach< T, Acc >( *n );
                         ++count;
                 } else {
                         m = n;
@@ -499,33 +663,44 @@ void range_qsort( T& first, T& last, Compare&& cmp = std::less<>{} ) noexcept(
 {
         if ( &first == &last )
                 return;
-        T& pivot     = first;
-        T* n         = _node( Acc::get( first ).next );
-        T* new_first = nullptr;
+        T&          pivot     = first;
+        T*          n         = _node( Acc::get( first ).next );
+        T*          new_first = nullptr;
+        T*          new_last  = &pivot;
+        std::size_t walk      = 1;
         for ( ;; ) {
+                ++walk;
                 T* next = _node( Acc::get( *n ).next );
                 if ( cmp( *n, pivot ) ) {
-                        detach( *n );
-                        link_detached_as_prev( pivot, *n );
+                        detach< T, Acc >( *n );
+                        link_detached_as_prev< T, Acc >( pivot, *n );
                         if ( !new_first )
                                 new_first = n;
+                } else {
+                        new_last = n;
                 }
                 if ( n == &last )
                         break;
                 n = next;
         }
-        if ( _node( Acc::get( pivot ).prev ) != &last )
-                range_qsort< T, Acc >( *_node( Acc::get( pivot ).next ), last, cmp );
+        ZLL_INSTRUMENT( T, instr_event::sort_walk, walk );
+        if ( new_last != &pivot )
+                range_qsort< T, Acc >( *_node( Acc::get( pivot ).next ), *new_last, cmp );
         if ( new_first )
                 range_qsort< T, Acc >( *new_first, *_node( Acc::get( pivot ).prev ), cmp );
 }
 
-/// Standard linked list iterator, needs just pointer to node
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ll_header< T, Acc > )
+struct ll_const_iterator;
+
+/// Standard linked list iterator, holds pointer to node. Past-the-end iterator also refers to the
+/// list, so that it can be decremented; it compares equal to `std::default_sentinel`.
 template < typename T, typename Acc = typename T::access >
 requires( _provides_ll_header< T, Acc > )
 struct ll_iterator
 {
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
         using value_type        = T;
         using difference_type   = std::ptrdiff_t;
         using pointer           = T*;
@@ -533,8 +708,15 @@ struct ll_iterator
 
         ll_iterator() noexcept = default;
 
-        ll_iterator( T* n ) noexcept
+        /// Iterator without the list can not step back from the end, containers pass the list.
+        constexpr ll_iterator( T* n ) noexcept
+          : _n( n )
+        {
+        }
+
+        constexpr ll_iterator( T* n, ll_list< T, Acc >* l ) noexcept
           : _n( n )
+          , _l( l )
         {
         }
 
@@ -552,7 +734,13 @@ struct ll_iterator
 
         ll_iterator& operator++() noexcept
         {
-                _n = _n ? _node( Acc::get( *_n ).next ) : nullptr;
+                ZLL_INSTRUMENT( T, instr_event::iter_step, 1 );
+                if ( !_n )
+                        return *this;
+                auto p = Acc::get( *_n ).next;
+                _n     = _node( p );
+                if ( !_n )
+                        _l = _list( p );
                 return *this;
         }
 
@@ -563,26 +751,54 @@ struct ll_iterator
                 return tmp;
         }
 
-        bool operator==( ll_iterator const& other ) const noexcept
+        ll_iterator& operator--() noexcept
+        {
+                ZLL_INSTRUMENT( T, instr_event::iter_step, 1 );
+                if ( _n ) {
+                        auto p = Acc::get( *_n ).prev;
+                        _n     = _node( p );
+                } else {
+                        ZLL_ASSERT( _l );
+                        _n = _l->last;
+                }
+                return *this;
+        }
+
+        ll_iterator operator--( int ) noexcept
+        {
+                ll_iterator tmp = *this;
+                --( *this );
+                return tmp;
+        }
+
+        constexpr bool operator==( ll_iterator const& other ) const noexcept
         {
                 return _n == other._n;
         }
 
+        constexpr bool operator==( std::default_sentinel_t ) const noexcept
+        {
+                return !_n;
+        }
+
         T* get() const noexcept
         {
                 return _n;
         }
 
 private:
-        T* _n = nullptr;
+        friend ll_const_iterator< T, Acc >;
+
+        T*                 _n = nullptr;
+        ll_list< T, Acc >* _l = nullptr;
 };
 
-/// Standard linked list const-iterator, needs just pointer to node
-template < typename T, typename Acc = typename T::access >
+/// Standard linked list const-iterator, see `ll_iterator`.
+template < typename T, typename Acc >
 requires( _provides_ll_header< T, Acc > )
 struct ll_const_iterator
 {
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
         using value_type        = T;
         using difference_type   = std::ptrdiff_t;
         using pointer           = T const*;
@@ -590,13 +806,21 @@ struct ll_const_iterator
 
         ll_const_iterator() noexcept = default;
 
-        ll_const_iterator( T const* n ) noexcept
+        /// Iterator without the list can not step back from the end, containers pass the list.
+        constexpr ll_const_iterator( T const* n ) noexcept
+          : _n( n )
+        {
+        }
+
+        constexpr ll_const_iterator( T const* n, ll_list< T, Acc > const* l ) noexcept
           : _n( n )
+          , _l( l )
         {
         }
 
         ll_const_iterator( ll_iterator< T, Acc > const& it ) noexcept
           : _n( it.get() )
+          , _l( it._l )
         {
         }
 
@@ -614,7 +838,13 @@ struct ll_const_iterator
 
         ll_const_iterator& operator++() noexcept
         {
-                _n = _n ? _node( Acc::get( *_n ).next ) : nullptr;
+                ZLL_INSTRUMENT( T, instr_event::iter_step, 1 );
+                if ( !_n )
+                        return *this;
+                auto p = Acc::get( *_n ).next;
+                _n     = _node( p );
+                if ( !_n )
+                        _l = _list( p );
                 return *this;
         }
 
@@ -625,15 +855,49 @@ struct ll_const_iterator
                 return tmp;
         }
 
-        bool operator==( ll_const_iterator const& other ) const noexcept
+        ll_const_iterator& operator--() noexcept
+        {
+                ZLL_INSTRUMENT( T, instr_event::iter_step, 1 );
+                if ( _n ) {
+                        auto p = Acc::get( *_n ).prev;
+                        _n     = _node( p );
+                } else {
+                        ZLL_ASSERT( _l );
+                        _n = _l->last;
+                }
+                return *this;
+        }
+
+        ll_const_iterator operator--( int ) noexcept
+        {
+                ll_const_iterator tmp = *this;
+                --( *this );
+                return tmp;
+        }
+
+        constexpr bool operator==( ll_const_iterator const& other ) const noexcept
         {
                 return _n == other._n;
         }
 
+        constexpr bool operator==( std::default_sentinel_t ) const noexcept
+        {
+                return !_n;
+        }
+
+        T const* get() const noexcept
+        {
+                return _n;
+        }
+
 private:
-        T const* _n = nullptr;
+        T const*                 _n = nullptr;
+        ll_list< T, Acc > const* _l = nullptr;
 };
 
+template < typename T, typename Acc, typename Compare >
+void _ll_merge_sort( ll_list< T, Acc >& l, Compare& cmp );
+
 /// Non-owning linked list container, expects nodes to contain ll_header as member.
 /// The nodes are linked together in a doubly linked list, with the first and last nodes
 /// accessible through the `front()` and `back()` methods.
@@ -650,7 +914,7 @@ struct ll_list
         static constexpr bool noexcept_access = _nothrow_access< Acc, T >;
 
         /// Default constructor creates an empty list.
-        ll_list() = default;
+        constexpr ll_list() noexcept = default;
 
         /// Constructs a list with nodes provided in the initializer list.
         /// Undefined behavior if any of the nodes is not detached.
@@ -714,34 +978,34 @@ struct ll_list
                 return *last;
         }
 
-        iterator begin() noexcept
+        constexpr iterator begin() noexcept
         {
-                return iterator{ first };
+                return iterator{ first, this };
         }
 
-        const_iterator begin() const noexcept
+        constexpr const_iterator begin() const noexcept
         {
-                return const_iterator{ first };
+                return const_iterator{ first, this };
         }
 
-        const_iterator cbegin() const noexcept
+        constexpr const_iterator cbegin() const noexcept
         {
-                return const_iterator{ first };
+                return const_iterator{ first, this };
         }
 
-        iterator end() noexcept
+        constexpr iterator end() noexcept
         {
-                return iterator{ nullptr };
+                return iterator{ nullptr, this };
         }
 
-        const_iterator end() const noexcept
+        constexpr const_iterator end() const noexcept
         {
-                return const_iterator{ nullptr };
+                return const_iterator{ nullptr, this };
         }
 
-        const_iterator cend() const noexcept
+        constexpr const_iterator cend() const noexcept
         {
-                return const_iterator{ nullptr };
+                return const_iterator{ nullptr, this };
         }
 
         /// Merge two lists together, seeh `merge_ranges` for details. Uses std::less<>{} for
@@ -758,6 +1022,7 @@ struct ll_list
         {
                 if ( this == &other || other.empty() )
                         return;
+                ZLL_PROBE3( ll_merge, this, other.first, other.last );
                 if ( empty() ) {
                         *this = std::move( other );
                         return;
@@ -800,6 +1065,7 @@ struct ll_list
         {
                 if ( this == &other || other.empty() )
                         return;
+                ZLL_PROBE3( ll_splice, this, other.first, other.last );
 
                 if ( empty() ) {
                         *this = std::move( other );
@@ -807,15 +1073,47 @@ struct ll_list
                         auto* f = other.first;
                         auto* l = other.last;
                         other.detach_nodes();
-                        link_range_as_next( *last, *f, *l );
+                        link_range_as_next< T, Acc >( *last, *f, *l );
                 } else {
                         auto* f = other.first;
                         auto* l = other.last;
                         other.detach_nodes();
-                        link_range_as_prev( *pos, *f, *l );
+                        link_range_as_prev< T, Acc >( *pos, *f, *l );
                 }
         }
 
+        /// Moves nodes [b, e) of list `other` into this list before position `pos` in constant
+        /// time. `other` may be this list, but `pos` must not be in the range.
+        void splice( iterator pos, ll_list& other, iterator b, iterator e ) noexcept(
+            noexcept_access )
+        {
+                if ( b == e )
+                        return;
+                T* f = b.get();
+                T* l = e == other.end() ? other.last : _node( Acc::get( *e ).prev );
+                detach_range< T, Acc >( *f, *l );
+                ZLL_PROBE3( ll_splice, this, f, l );
+                if ( pos == end() )
+                        link_range_back( *f, *l );
+                else
+                        link_range_as_prev< T, Acc >( *pos, *f, *l );
+        }
+
+        /// Cuts the list after node at `pos` in constant time, returns list of the following nodes.
+        /// `pos` has to point to a node of the list.
+        ll_list split_after( iterator pos ) noexcept( noexcept_access )
+        {
+                ll_list res;
+                T*      n = pos.get();
+                if ( n == last )
+                        return res;
+                T* f = _node( Acc::get( *n ).next );
+                T* l = last;
+                detach_range< T, Acc >( *f, *l );
+                res.link_range_back( *f, *l );
+                return res;
+        }
+
         /// Reverses the order of nodes in the list. The first node becomes the last and the last
         /// node becomes the first.
         void reverse() noexcept( noexcept_access )
@@ -851,6 +1149,7 @@ struct ll_list
         {
                 if ( empty() )
                         return;
+                ZLL_PROBE1( ll_sort, this );
                 range_qsort< T, Acc >( *first, *last, std::forward< Compare >( cmp ) );
         }
 
@@ -860,6 +1159,88 @@ struct ll_list
                 sort( std::less<>{} );
         }
 
+        /// Links the node `node` into sorted list so that the list stays sorted according to
+        /// `cmp`, `node` is placed after all nodes equal to it. The search starts at `hint` and
+        /// walks towards the insertion point in either direction, hence it is cheap for nodes that
+        /// belong near `hint`. If `hint` is `end()`, the search starts at the last node. Detaches
+        /// `node` from any other list it might be attached to. Returns iterator to `node`, which
+        /// is a good hint for locally ordered insertions.
+        template < typename Compare >
+        iterator insert_sorted( iterator hint, T& node, Compare&& cmp ) noexcept(
+            noexcept_access && noexcept( cmp( node, node ) ) )
+        {
+                T* p = hint == end() ? last : hint.get();
+                if ( p == &node ) {
+                        auto& h = Acc::get( node );
+                        p       = _node( h.next ) ? _node( h.next ) : _node( h.prev );
+                }
+                detach< T, Acc >( node );
+                if ( !p ) {
+                        link_back( node );
+                        return iterator{ &node, this };
+                }
+
+                if ( !cmp( node, *p ) ) {
+                        T* n = _node( Acc::get( *p ).next );
+                        while ( n && !cmp( node, *n ) ) {
+                                p = n;
+                                n = _node( Acc::get( *n ).next );
+                        }
+                        link_detached_as_next< T, Acc >( *p, node );
+                } else {
+                        T* n = _node( Acc::get( *p ).prev );
+                        while ( n && cmp( node, *n ) ) {
+                                p = n;
+                                n = _node( Acc::get( *n ).prev );
+                        }
+                        link_detached_as_prev< T, Acc >( *p, node );
+                }
+                return iterator{ &node, this };
+        }
+
+        /// Links the node `node` into sorted list, see `insert_sorted` above. Uses `std::less<>`
+        /// for comparison.
+        iterator insert_sorted( iterator hint, T& node ) noexcept(
+            noexcept_access && noexcept( std::less<>{}( node, node ) ) )
+        {
+                return insert_sorted( hint, node, std::less<>{} );
+        }
+
+        /// Links the node `node` into sorted list, the search starts at the last node. See
+        /// `insert_sorted` above.
+        template < typename Compare >
+        iterator insert_sorted( T& node, Compare&& cmp ) noexcept(
+            noexcept_access && noexcept( cmp( node, node ) ) )
+        {
+                return insert_sorted( end(), node, std::forward< Compare >( cmp ) );
+        }
+
+        /// Links the node `node` into sorted list, the search starts at the last node. Uses
+        /// `std::less<>` for comparison.
+        iterator insert_sorted( T& node ) noexcept(
+            noexcept_access && noexcept( std::less<>{}( node, node ) ) )
+        {
+                return insert_sorted( end(), node, std::less<>{} );
+        }
+
+        /// Links all nodes of `other` into sorted list. The nodes of `other` are sorted first by
+        /// stable bottom-up merge sort, which is O(n log n) also for already sorted batches, and
+        /// then merged with this list in one pass, see `merge`. The `other` list becomes empty.
+        template < typename Compare >
+        void insert_sorted( ll_list&& other, Compare&& cmp ) noexcept(
+            noexcept_access && noexcept( cmp( *first, *last ) ) )
+        {
+                _ll_merge_sort( other, cmp );
+                merge( std::move( other ), std::forward< Compare >( cmp ) );
+        }
+
+        /// Links all nodes of `other` into sorted list. Uses `std::less<>` for comparison.
+        void insert_sorted( ll_list&& other ) noexcept(
+            noexcept_access && noexcept( std::less<>{}( *first, *last ) ) )
+        {
+                insert_sorted( std::move( other ), std::less<>{} );
+        }
+
         /// Links the node `node` as the first element of the list. The previous first element
         /// becomes the second element. Detaches `node` from any other list it might be
         /// attached to.
@@ -889,7 +1270,7 @@ struct ll_list
         }
 
         /// Returns true if the list is empty, i.e. contains no elements.
-        bool empty() const noexcept
+        constexpr bool empty() const noexcept
         {
                 return !first;
         }
@@ -906,6 +1287,21 @@ struct ll_list
                         link_first( node );
         }
 
+        /// Links detached range [f, l] as the last elements of the list.
+        /// Undefined behavior if the range is not detached.
+        void link_range_back( T& f, T& l ) noexcept( noexcept_access )
+        {
+                ZLL_ASSERT( ( detached_range< T, Acc >( f, l ) ) );
+                if ( last ) {
+                        link_range_as_next< T, Acc >( *last, f, l );
+                } else {
+                        first              = &f;
+                        last               = &l;
+                        Acc::get( f ).prev = *this;
+                        Acc::get( l ).next = *this;
+                }
+        }
+
         /// Detaches the last element of the list. The second last element becomes the last
         /// element. Undefined behavior if the list is empty.
         void detach_back() noexcept( noexcept_access )
@@ -922,9 +1318,30 @@ struct ll_list
                 return node;
         }
 
-        /// Detaches all nodes in the list. The list becomes empty after this operation.
-        /// The nodes themselves are still linked together, but not to this list.
-        ~ll_list() noexcept( noexcept_access )
+        /// Empties the list in constant time. The nodes stay linked together as detached range
+        /// [front, back], which can be linked to another list with `link_range_back`, and any of
+        /// them can be destroyed or detached individually. Only the end nodes are detached.
+        constexpr void clear_fast() noexcept( noexcept_access )
+        {
+                detach_nodes();
+        }
+
+        /// Empties the list and detaches every node, in one walk over the list.
+        void clear() noexcept( noexcept_access )
+        {
+                T* n  = first;
+                first = nullptr;
+                last  = nullptr;
+                while ( n ) {
+                        auto& h = Acc::get( *n );
+                        n       = _node( h.next );
+                        h.next  = nullptr;
+                        h.prev  = nullptr;
+                }
+        }
+
+        /// Empties the list in constant time, see `clear_fast`.
+        constexpr ~ll_list() noexcept( noexcept_access )
         {
                 detach_nodes();
         }
@@ -933,7 +1350,7 @@ struct ll_list
         T* last  = nullptr;
 
 private:
-        void detach_nodes() noexcept( noexcept_access )
+        constexpr void detach_nodes() noexcept( noexcept_access )
         {
                 if ( first )
                         Acc::get( *first ).prev = nullptr;
@@ -953,6 +1370,77 @@ private:
         }
 };
 
+/// Merges two sorted chains of nodes linked only through `next` and terminated by nullptr.
+/// Returns the head of the merged chain, equal nodes from `a` precede the ones from `b`.
+template < typename T, typename Acc, typename Compare >
+T* _ll_chain_merge( T* a, T* b, Compare& cmp )
+{
+        T* head = nullptr;
+        T* tail = nullptr;
+        while ( a && b ) {
+                T*& src = cmp( *b, *a ) ? b : a;
+                if ( tail )
+                        Acc::get( *tail ).next = *src;
+                else
+                        head = src;
+                tail = src;
+                src  = _node( Acc::get( *src ).next );
+        }
+        T* rest = a ? a : b;
+        if ( !tail )
+                return rest;
+        if ( rest )
+                Acc::get( *tail ).next = *rest;
+        return head;
+}
+
+/// Stable bottom-up merge sort of the list. Unlike `ll_list::sort` it does not recurse and is
+/// O(n log n) for any input. During the sort nodes are linked only through `next`, sorted runs
+/// of growing size are kept in bins, `prev` links are restored in one final pass.
+template < typename T, typename Acc, typename Compare >
+void _ll_merge_sort( ll_list< T, Acc >& l, Compare& cmp )
+{
+        constexpr std::size_t bin_count = 64;
+
+        if ( l.empty() )
+                return;
+        T* n = &l.front();
+        detach_range< T, Acc >( *n, l.back() );
+
+        T*          bins[bin_count] = {};
+        std::size_t used            = 0;
+        while ( n ) {
+                T* carry = n;
+                n        = _node( Acc::get( *n ).next );
+                Acc::get( *carry ).next = nullptr;
+                std::size_t i           = 0;
+                for ( ; i < used && bins[i]; i++ ) {
+                        carry   = _ll_chain_merge< T, Acc >( bins[i], carry, cmp );
+                        bins[i] = nullptr;
+                }
+                if ( i == bin_count )
+                        --i;
+                bins[i] = carry;
+                if ( i == used )
+                        ++used;
+        }
+
+        T* head = nullptr;
+        for ( std::size_t i = 0; i < used; i++ )
+                if ( bins[i] )
+                        head = head ? _ll_chain_merge< T, Acc >( bins[i], head, cmp ) : bins[i];
+
+        T* prev = nullptr;
+        for ( T* x = head; x; x = _node( Acc::get( *x ).next ) ) {
+                if ( prev )
+                        Acc::get( *x ).prev = *prev;
+                else
+                        Acc::get( *x ).prev = nullptr;
+                prev = x;
+        }
+        l.link_range_back( *head, *prev );
+}
+
 /// CRTP base class for linked list nodes containing `ll_header`. Provides access type to the header
 /// of the node and implements move and copy semantics for the node. Provides basic API for the
 /// node.
@@ -1067,6 +1555,109 @@ private:
         ll_header< Derived, access > _hdr;
 };
 
+template < typename Derived, typename Tag >
+struct _ll_tag_hdr;
+
+/// Access type to the header of `ll_multi_base` selected by `Tag`.
+template < typename Tag >
+struct tag_access
+{
+        template < typename T >
+        requires( std::derived_from< T, _ll_tag_hdr< T, Tag > > )
+        static auto& get( T& d ) noexcept
+        {
+                return static_cast< _ll_tag_hdr< T, Tag >& >( d )._hdr;
+        }
+
+        template < typename T >
+        requires( std::derived_from< T, _ll_tag_hdr< T, Tag > > )
+        static auto const& get( T const& d ) noexcept
+        {
+                return static_cast< _ll_tag_hdr< T, Tag > const& >( d )._hdr;
+        }
+};
+
+/// Header of `ll_multi_base` for one tag.
+template < typename Derived, typename Tag >
+struct _ll_tag_hdr
+{
+        ll_header< Derived, tag_access< Tag > > _hdr;
+};
+
+/// Base class for nodes that are members of multiple lists at once, one header is embedded for
+/// each of `Tags`. List of nodes linked through header of `Tag` is `ll_list< Derived, tag_access<
+/// Tag > >`.
+///
+/// Move and copy handle all the headers at once with the same semantics as `ll_base`: the moved-to
+/// node replaces the moved-from node in each of its lists.
+template < typename Derived, typename... Tags >
+struct ll_multi_base : _ll_tag_hdr< Derived, Tags >...
+{
+        /// Default constructor node is detached from all lists
+        ll_multi_base() noexcept = default;
+
+        /// Move constructor, moved-from node is detached. The new node is linked to the lists of
+        /// the moved-from node instead of it.
+        ll_multi_base( ll_multi_base&& o ) noexcept
+        {
+                ( move_from_to< Derived, tag_access< Tags > >( o.derived(), derived() ), ... );
+        }
+
+        /// Copy constructor, copied node is linked to the lists of the copied node after it.
+        ll_multi_base( ll_multi_base& o ) noexcept
+        {
+                ( link_detached_as_next< Derived, tag_access< Tags > >( o.derived(), derived() ),
+                  ... );
+        }
+
+        /// Move assignment operator, moved-from node is detached. The new node is linked to the
+        /// lists of the moved-from node instead of it.
+        ll_multi_base& operator=( ll_multi_base&& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                detach_all();
+                ( move_from_to< Derived, tag_access< Tags > >( o.derived(), derived() ), ... );
+                return *this;
+        }
+
+        /// Copy assignment operator, copied node is linked to the lists of the copied node after
+        /// it.
+        ll_multi_base& operator=( ll_multi_base& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                detach_all();
+                ( link_detached_as_next< Derived, tag_access< Tags > >( o.derived(), derived() ),
+                  ... );
+                return *this;
+        }
+
+        /// Unlinks the node from all the lists.
+        void detach_all() noexcept
+        {
+                ( detach< Derived, tag_access< Tags > >( derived() ), ... );
+        }
+
+        /// Returns true if the node is linked through the header of `Tag`.
+        template < typename Tag >
+        bool linked() const noexcept
+        {
+                return !detached< Derived const, tag_access< Tag > >( derived() );
+        }
+
+protected:
+        Derived& derived()
+        {
+                return *static_cast< Derived* >( this );
+        }
+
+        Derived const& derived() const
+        {
+                return *static_cast< Derived const* >( this );
+        }
+};
+
 /// Iterate over all nodes in the list starting from `n` and call `f` for each node.
 /// The order of the nodes is: predecessors, `n`, successors.
 template < typename T, typename Acc = typename T::access >
@@ -1103,31 +1694,487 @@ T* find_if_node( T& n, std::invocable< T& > auto&& f ) noexcept(
         return nullptr;
 }
 
-template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
-struct sh_header;
+/// Header of a node of `ll_ring`. Links point directly to headers of neighbours or to the sentinel
+/// header owned by the ring, so linking and unlinking never checks what is on the other side.
+/// Detached header has both links null.
+struct ll_ring_header
+{
+        ll_ring_header* next = nullptr;
+        ll_ring_header* prev = nullptr;
 
-template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
-struct sh_heap;
+        constexpr ll_ring_header() noexcept                        = default;
+        ll_ring_header( ll_ring_header&& other ) noexcept            = delete;
+        ll_ring_header( ll_ring_header const& other )                = delete;
+        ll_ring_header& operator=( ll_ring_header&& other ) noexcept = delete;
+        ll_ring_header& operator=( ll_ring_header const& other )     = delete;
 
-template < typename T, typename Acc, typename Compare = std::less<> >
-concept _provides_sh_header = requires( T t ) {
+        constexpr ~ll_ring_header() noexcept
         {
-                Acc::get( t )
-        } -> std::convertible_to<
-              sh_header< std::remove_const_t< T >, Acc, std::remove_cvref_t< Compare > > const& >;
-};
+                if ( next ) {
+                        prev->next = next;
+                        next->prev = prev;
+                }
+        }
+};
 
-template < typename T, typename Acc, typename Compare = std::less<> >
-using _sh_ptr = _vptr< T, sh_heap< T, Acc, Compare > >;
+/// Links detached header `h` before header `pos`.
+constexpr void _ring_link_before( ll_ring_header& pos, ll_ring_header& h ) noexcept
+{
+        ZLL_ASSERT( !h.next && !h.prev );
+        h.next         = &pos;
+        h.prev         = pos.prev;
+        pos.prev->next = &h;
+        pos.prev       = &h;
+}
 
-template < typename T, typename Acc, typename Compare = std::less<> >
-auto* _node( _sh_ptr< T, Acc, Compare > p ) noexcept
+/// Unlinks linked header `h`, its neighbours are linked together.
+constexpr void _ring_unlink( ll_ring_header& h ) noexcept
+{
+        ZLL_ASSERT( h.next && h.prev );
+        h.prev->next = h.next;
+        h.next->prev = h.prev;
+        h.next       = nullptr;
+        h.prev       = nullptr;
+}
+
+/// Makes header `to` take place of linked header `from`, `from` is detached afterwards.
+constexpr void _ring_replace( ll_ring_header& from, ll_ring_header& to ) noexcept
+{
+        ZLL_ASSERT( !to.next && !to.prev );
+        to.next       = from.next;
+        to.prev       = from.prev;
+        to.next->prev = &to;
+        to.prev->next = &to;
+        from.next     = nullptr;
+        from.prev     = nullptr;
+}
+
+template < typename T, typename Acc >
+concept _provides_ring_header = requires( T& t, ll_ring_header& h ) {
+        {
+                Acc::get( t )
+        } -> std::convertible_to< ll_ring_header const& >;
+        {
+                Acc::node( h )
+        } -> std::convertible_to< T const& >;
+};
+
+/// Unlinks the node from its ring, neighbours are linked together. Does nothing for detached node.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ring_header< T, Acc > )
+constexpr void detach( T& node ) noexcept
+{
+        ZLL_INSTRUMENT( T, instr_event::detach, 1 );
+        auto& h = Acc::get( node );
+        if ( h.next )
+                _ring_unlink( h );
+}
+
+/// Returns true if the node is not linked into any ring.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ring_header< T, Acc > )
+constexpr bool detached( T const& node ) noexcept
+{
+        return !Acc::get( node ).next;
+}
+
+/// Bidirectional iterator over `ll_ring`, `T` is const for const iteration.
+template < typename T, typename Acc = typename std::remove_const_t< T >::access >
+struct ll_ring_iterator
+{
+        using header_type =
+            std::conditional_t< std::is_const_v< T >, ll_ring_header const, ll_ring_header >;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = std::remove_const_t< T >;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T*;
+        using reference         = T&;
+
+        constexpr ll_ring_iterator() noexcept = default;
+
+        constexpr ll_ring_iterator( header_type* h ) noexcept
+          : _h( h )
+        {
+        }
+
+        constexpr reference operator*() const noexcept
+        {
+                return Acc::node( *_h );
+        }
+
+        constexpr pointer operator->() const noexcept
+        {
+                return &Acc::node( *_h );
+        }
+
+        constexpr ll_ring_iterator& operator++() noexcept
+        {
+                ZLL_INSTRUMENT( value_type, instr_event::iter_step, 1 );
+                _h = _h->next;
+                return *this;
+        }
+
+        constexpr ll_ring_iterator operator++( int ) noexcept
+        {
+                ll_ring_iterator tmp = *this;
+                ++( *this );
+                return tmp;
+        }
+
+        constexpr ll_ring_iterator& operator--() noexcept
+        {
+                ZLL_INSTRUMENT( value_type, instr_event::iter_step, 1 );
+                _h = _h->prev;
+                return *this;
+        }
+
+        constexpr ll_ring_iterator operator--( int ) noexcept
+        {
+                ll_ring_iterator tmp = *this;
+                --( *this );
+                return tmp;
+        }
+
+        constexpr bool operator==( ll_ring_iterator const& other ) const noexcept = default;
+
+private:
+        header_type* _h = nullptr;
+};
+
+/// Circular doubly linked list with sentinel header. Unlike `ll_list`, links of nodes point only
+/// to headers, the ring itself owns sentinel header that is both before the first and after the
+/// last node. Link and unlink are four unconditional stores. Nodes are required to derive from
+/// `ll_ring_base`, or provide accessor with `get( T& )` returning header and `node( header& )`
+/// returning the node for header.
+///
+/// When the ring is destroyed its nodes stay linked together in a circle without the sentinel.
+///
+/// All operations are constexpr, so a ring and its nodes can be wired together during constant
+/// initialization of one `constinit` object, e.g. a registry of statically declared components.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_ring_header< T, Acc > )
+struct ll_ring
+{
+        using value_type     = T;
+        using iterator       = ll_ring_iterator< T, Acc >;
+        using const_iterator = ll_ring_iterator< T const, Acc >;
+
+        /// Default constructor creates an empty ring.
+        constexpr ll_ring() noexcept
+        {
+                _head.next = &_head;
+                _head.prev = &_head;
+        }
+
+        /// Constructs a ring with nodes provided in the initializer list.
+        constexpr ll_ring( std::initializer_list< T* > il ) noexcept
+          : ll_ring()
+        {
+                for ( auto* n : il ) {
+                        ZLL_ASSERT( n );
+                        link_back( *n );
+                }
+        }
+
+        ll_ring( ll_ring const& )            = delete;
+        ll_ring& operator=( ll_ring const& ) = delete;
+
+        /// Move constructor. Moved-from ring is empty after move.
+        constexpr ll_ring( ll_ring&& other ) noexcept
+          : ll_ring()
+        {
+                *this = std::move( other );
+        }
+
+        /// Move assignment operator. Nodes of this ring are left linked in a circle without the
+        /// sentinel, moved-from ring is empty after move.
+        constexpr ll_ring& operator=( ll_ring&& other ) noexcept
+        {
+                if ( this == &other )
+                        return *this;
+                _ring_unlink( _head );
+                if ( other.empty() ) {
+                        _head.next = &_head;
+                        _head.prev = &_head;
+                } else {
+                        _ring_replace( other._head, _head );
+                        other._head.next = &other._head;
+                        other._head.prev = &other._head;
+                }
+                return *this;
+        }
+
+        /// Returns true if the ring contains no nodes.
+        constexpr bool empty() const noexcept
+        {
+                return _head.next == &_head;
+        }
+
+        constexpr T& front() noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                return Acc::node( *_head.next );
+        }
+
+        constexpr T const& front() const noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                return Acc::node( *_head.next );
+        }
+
+        constexpr T& back() noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                return Acc::node( *_head.prev );
+        }
+
+        constexpr T const& back() const noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                return Acc::node( *_head.prev );
+        }
+
+        constexpr iterator begin() noexcept
+        {
+                return iterator{ _head.next };
+        }
+
+        constexpr const_iterator begin() const noexcept
+        {
+                return const_iterator{ _head.next };
+        }
+
+        constexpr iterator end() noexcept
+        {
+                return iterator{ &_head };
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+                return const_iterator{ &_head };
+        }
+
+        /// Links the node as the first node of the ring. Detaches `node` from any other ring it
+        /// might be linked into.
+        constexpr void link_front( T& node ) noexcept
+        {
+                detach< T, Acc >( node );
+                ZLL_INSTRUMENT( T, instr_event::link, 1 );
+                _ring_link_before( *_head.next, Acc::get( node ) );
+        }
+
+        /// Links the node as the last node of the ring. Detaches `node` from any other ring it
+        /// might be linked into.
+        constexpr void link_back( T& node ) noexcept
+        {
+                detach< T, Acc >( node );
+                ZLL_INSTRUMENT( T, instr_event::link, 1 );
+                _ring_link_before( _head, Acc::get( node ) );
+        }
+
+        /// Links the node before position `pos`. Detaches `node` from any other ring it might be
+        /// linked into.
+        constexpr void link_before( iterator pos, T& node ) noexcept
+        {
+                detach< T, Acc >( node );
+                ZLL_INSTRUMENT( T, instr_event::link, 1 );
+                _ring_link_before( pos == end() ? _head : Acc::get( *pos ), Acc::get( node ) );
+        }
+
+        /// Detaches and returns the first node. Undefined behavior if the ring is empty.
+        constexpr T& take_front() noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                auto& h = *_head.next;
+                _ring_unlink( h );
+                return Acc::node( h );
+        }
+
+        /// Detaches and returns the last node. Undefined behavior if the ring is empty.
+        constexpr T& take_back() noexcept
+        {
+                ZLL_ASSERT( !empty() );
+                auto& h = *_head.prev;
+                _ring_unlink( h );
+                return Acc::node( h );
+        }
+
+        /// Detaches all nodes of the ring, walks over all of them.
+        constexpr void clear() noexcept
+        {
+                while ( !empty() )
+                        _ring_unlink( *_head.next );
+        }
+
+private:
+        ll_ring_header _head;
+};
+
+/// CRTP base class for nodes of `ll_ring`. Provides access type and implements move and copy
+/// semantics the same way as `ll_base`: moved-to node takes place of the moved-from node, copy is
+/// linked after the copied node.
+template < typename Derived >
+struct ll_ring_base : protected ll_ring_header
+{
+        /// Access type to the header of ll_ring_base.
+        struct access
+        {
+                static constexpr ll_ring_header& get( Derived& d ) noexcept
+                {
+                        return static_cast< ll_ring_base& >( d );
+                }
+
+                static constexpr ll_ring_header const& get( Derived const& d ) noexcept
+                {
+                        return static_cast< ll_ring_base const& >( d );
+                }
+
+                static constexpr Derived& node( ll_ring_header& h ) noexcept
+                {
+                        return static_cast< Derived& >( static_cast< ll_ring_base& >( h ) );
+                }
+
+                static constexpr Derived const& node( ll_ring_header const& h ) noexcept
+                {
+                        return static_cast< Derived const& >(
+                            static_cast< ll_ring_base const& >( h ) );
+                }
+        };
+
+        /// Default constructor, node is detached.
+        constexpr ll_ring_base() noexcept = default;
+
+        /// Move constructor, the new node takes place of the moved-from node which is detached.
+        constexpr ll_ring_base( ll_ring_base&& o ) noexcept
+        {
+                if ( o.next )
+                        _ring_replace( o, *this );
+        }
+
+        /// Copy constructor, the new node is linked after the copied node.
+        constexpr ll_ring_base( ll_ring_base& o ) noexcept
+        {
+                if ( o.next )
+                        _ring_link_before( *o.next, *this );
+        }
+
+        /// Move assignment operator, the node takes place of the moved-from node which is
+        /// detached.
+        constexpr ll_ring_base& operator=( ll_ring_base&& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                if ( next )
+                        _ring_unlink( *this );
+                if ( o.next )
+                        _ring_replace( o, *this );
+                return *this;
+        }
+
+        /// Copy assignment operator, the node is linked after the copied node.
+        constexpr ll_ring_base& operator=( ll_ring_base& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                if ( next )
+                        _ring_unlink( *this );
+                if ( o.next )
+                        _ring_link_before( *o.next, *this );
+                return *this;
+        }
+};
+
+/// Statistics policy of `sh_heap` that keeps no data, all statistics hooks compile to nothing.
+struct sh_no_stats
+{
+};
+
+/// Statistics policy of `sh_heap` that keeps the number of nodes in the heap.
+///
+/// Operations of the heap update the count in O(1). Node linked or unlinked directly (destructor,
+/// copy or move-assignment of `sh_base`, free `detach`, `link_detached` or `link_detached_to`)
+/// finds its heap by walking up to the top node, which is O(depth) and paid only with this policy;
+/// `sh_heap::detach` avoids the walk.
+struct sh_stats
+{
+        /// Number of nodes in the heap.
+        std::size_t size = 0;
+};
+
+/// Statistics policy of `sh_heap` that keeps the number of nodes like `sh_stats` and also records
+/// merge steps of heap operations and the longest merge path.
+struct sh_debug_stats : sh_stats
+{
+        /// Merge steps (comparisons) done by the last operation of the heap.
+        std::size_t last_merge_steps = 0;
+        /// Maximal number of merge steps done by single operation of the heap.
+        std::size_t max_merge_steps = 0;
+        /// Longest merge path of single `link`, `merge`, `pop` or `detach`, that is the number of
+        /// right spine nodes of both inputs walked by the merge.
+        std::size_t max_right_spine = 0;
+};
+
+template < typename Stats >
+concept _sh_counts_nodes = requires( Stats& s ) {
+        {
+                s.size
+        } -> std::same_as< std::size_t& >;
+};
+
+template < typename Stats >
+concept _sh_counts_steps = requires( Stats& s ) {
+        {
+                s.last_merge_steps
+        } -> std::same_as< std::size_t& >;
+        {
+                s.max_merge_steps
+        } -> std::same_as< std::size_t& >;
+        {
+                s.max_right_spine
+        } -> std::same_as< std::size_t& >;
+};
+
+template <
+    typename T,
+    typename Acc     = typename T::access,
+    typename Compare = std::less<>,
+    typename Stats   = sh_no_stats >
+struct sh_header;
+
+template <
+    typename T,
+    typename Acc     = typename T::access,
+    typename Compare = std::less<>,
+    typename Stats   = sh_no_stats >
+struct sh_heap;
+
+template < typename H >
+struct _is_sh_header : std::false_type
+{
+};
+
+template < typename T, typename Acc, typename Compare, typename Stats >
+struct _is_sh_header< sh_header< T, Acc, Compare, Stats > > : std::true_type
+{
+};
+
+template < typename T, typename Acc >
+concept _provides_sh_header = requires( T& t ) {
+        requires _is_sh_header< std::remove_cvref_t< decltype( Acc::get( t ) ) > >::value;
+};
+
+template < typename T, typename Acc, typename Compare = std::less<>, typename Stats = sh_no_stats >
+using _sh_ptr = _vptr< T, sh_heap< T, Acc, Compare, Stats >, 1 >;
+
+template < typename T, typename Acc, typename Compare, typename Stats >
+auto* _node( _sh_ptr< T, Acc, Compare, Stats > p ) noexcept
 {
         return p.a();
 }
 
-template < typename T, typename Acc, typename Compare = std::less<> >
-auto* _heap( _sh_ptr< T, Acc, Compare > p ) noexcept
+template < typename T, typename Acc, typename Compare, typename Stats >
+auto* _heap( _sh_ptr< T, Acc, Compare, Stats > p ) noexcept
 {
         return p.b();
 }
@@ -1150,8 +2197,8 @@ T& _detach_left( T& node ) noexcept( _nothrow_access< Acc, T > )
         return tmp;
 }
 
-template < typename T, typename Acc, typename Compare >
-T& _detach_top( sh_heap< T, Acc, Compare >& parent ) noexcept( _nothrow_access< Acc, T > )
+template < typename T, typename Acc, typename Compare, typename Stats >
+T& _detach_top( sh_heap< T, Acc, Compare, Stats >& parent ) noexcept( _nothrow_access< Acc, T > )
 {
         T& tmp                 = *parent.top;
         Acc::get( tmp ).parent = nullptr;
@@ -1177,14 +2224,32 @@ auto _detach_parent( T& node ) noexcept( _nothrow_access< Acc, T > )
 }
 
 /// Returns true if the node is detached from heap.
-template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
-requires( _provides_sh_header< T, Acc, Compare > )
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
 bool detached( T& node ) noexcept( _nothrow_access< Acc, T > )
 {
         auto& n_hdr = Acc::get( node );
         return !n_hdr.left && !n_hdr.right && !n_hdr.parent;
 }
 
+/// Returns user flag stored in spare bit of the header of `node`, one flag is available. The flag
+/// belongs to the node: it is kept while the node is linked or detached and `move_from_to` does
+/// not transfer it.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+std::uintptr_t node_flags( T const& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        return Acc::get( node ).parent.flags();
+}
+
+/// Sets user flag stored in spare bit of the header of `node`, see `node_flags`.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+void set_node_flags( T& node, std::uintptr_t f ) noexcept( _nothrow_access< Acc, T > )
+{
+        Acc::get( node ).parent.set_flags( f );
+}
+
 template < typename T, typename Acc >
 void _attach_right( T& parent, T& node ) noexcept( _nothrow_access< Acc, T > )
 {
@@ -1199,16 +2264,17 @@ void _attach_left( T& parent, T& node ) noexcept( _nothrow_access< Acc, T > )
         Acc::get( node ).parent = parent;
 }
 
-template < typename T, typename Acc, typename Compare >
-void _attach_top( sh_heap< T, Acc, Compare >& parent, T& node ) noexcept(
+template < typename T, typename Acc, typename Compare, typename Stats >
+void _attach_top( sh_heap< T, Acc, Compare, Stats >& parent, T& node ) noexcept(
     _nothrow_access< Acc, T > )
 {
         parent.top              = &node;
         Acc::get( node ).parent = parent;
 }
 
-template < typename T, typename Acc, typename Compare >
-void _attach_parent( T& node, _sh_ptr< T, Acc, Compare > p ) noexcept( _nothrow_access< Acc, T > )
+template < typename T, typename Acc, typename Compare, typename Stats >
+void _attach_parent( T& node, _sh_ptr< T, Acc, Compare, Stats > p ) noexcept(
+    _nothrow_access< Acc, T > )
 {
         Acc::get( node ).parent = p;
         if ( auto* n = _node( p ) ) {
@@ -1221,6 +2287,35 @@ void _attach_parent( T& node, _sh_ptr< T, Acc, Compare > p ) noexcept( _nothrow_
         }
 }
 
+/// Returns the heap containing `node` or nullptr if tree of `node` is not linked to any heap.
+template < typename T, typename Acc >
+auto* _sh_heap_of( T& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto p = Acc::get( node ).parent;
+        while ( auto* n = _node( p ) )
+                p = Acc::get( *n ).parent;
+        return _heap( p );
+}
+
+/// Updates node count of the heap containing `node` after it was linked or before it is unlinked.
+/// No-op unless statistics policy of the heap counts nodes.
+template < typename T, typename Acc >
+void _sh_count( T& node, bool linked ) noexcept( _nothrow_access< Acc, T > )
+{
+        using heap_type = std::remove_pointer_t< decltype( _sh_heap_of< T, Acc >( node ) ) >;
+        if constexpr ( _sh_counts_nodes< decltype( heap_type::stats ) > ) {
+                if ( auto* h = _sh_heap_of< T, Acc >( node ) ) {
+                        if ( linked )
+                                ++h->stats.size;
+                        else
+                                --h->stats.size;
+                }
+        } else {
+                (void) node;
+                (void) linked;
+        }
+}
+
 template < typename T, typename Acc, typename Compare >
 T& _sh_merge( T& left, T& right, Compare&& comp ) noexcept(
     _nothrow_access_compare< Acc, T, Compare > );
@@ -1250,6 +2345,7 @@ template < typename T, typename Acc, typename Compare >
 T& _sh_merge( T& left, T& right, Compare&& comp ) noexcept(
     _nothrow_access_compare< Acc, T, Compare > )
 {
+        ZLL_INSTRUMENT( T, instr_event::merge_step, 1 );
         ZLL_ASSERT( !Acc::get( left ).parent );
         ZLL_ASSERT( !Acc::get( right ).parent );
 
@@ -1259,29 +2355,1134 @@ T& _sh_merge( T& left, T& right, Compare&& comp ) noexcept(
                 return _sh_merge_impl< T, Acc >( left, right, comp );
 }
 
-template < typename T, typename Acc >
-void _replace_in_parent( T& node, T& new_node ) noexcept( _nothrow_access< Acc, T > )
+template < typename T, typename Acc >
+void _replace_in_parent( T& node, T& new_node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto& parent = Acc::get( node ).parent;
+
+        if ( auto* n = _node( parent ) ) {
+                if ( Acc::get( *n ).left == &node )
+                        _attach_left< T, Acc >( *n, new_node );
+                else if ( Acc::get( *n ).right == &node )
+                        _attach_right< T, Acc >( *n, new_node );
+        } else if ( auto* h = _heap( parent ) ) {
+                _attach_top( *h, new_node );
+        }
+
+        parent = nullptr;
+}
+
+/// Links all children from `from` node to `to` node. The `to` node must be detached.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+void move_from_to( T& from, T& to ) noexcept( _nothrow_access< Acc, T > )
+{
+        ZLL_ASSERT( ( detached< T, Acc >( to ) ) );
+        ZLL_INSTRUMENT( T, instr_event::move, 1 );
+
+        if ( Acc::get( from ).left ) {
+                auto& l = _detach_left< T, Acc >( from );
+                _attach_left< T, Acc >( to, l );
+        }
+        if ( Acc::get( from ).right ) {
+                auto& r = _detach_right< T, Acc >( from );
+                _attach_right< T, Acc >( to, r );
+        }
+        if ( Acc::get( from ).parent )
+                _replace_in_parent< T, Acc >( from, to );
+}
+
+/// Links detached `copy` of `node` as right child of `node`, former right subtree of `node` becomes
+/// right subtree of `copy`. The copy is equal to `node`, so no comparison is needed - members of
+/// the copy are not yet copied when called from the copy constructor of the base.
+template < typename T, typename Acc >
+void _sh_link_copy( T& node, T& copy ) noexcept( _nothrow_access< Acc, T > )
+{
+        ZLL_ASSERT( ( detached< T, Acc >( copy ) ) );
+        if ( Acc::get( node ).right )
+                _attach_right< T, Acc >( copy, _detach_right< T, Acc >( node ) );
+        _attach_right< T, Acc >( node, copy );
+        _sh_count< T, Acc >( copy, true );
+}
+
+/// Link a detached node `other` to `node`. Maintains the heap property using `comp`. The `other`
+/// node must be detached before calling this function.
+template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
+requires( _provides_sh_header< T, Acc > )
+void link_detached_to( T& node, T& other, Compare&& comp = std::less<>{} ) noexcept(
+    _nothrow_access_compare< Acc, T, Compare > )
+{
+        ZLL_ASSERT( ( detached< T, Acc >( other ) ) );
+
+        T* n = nullptr;
+        if ( Acc::get( node ).right ) {
+                auto& r = _detach_right< T, Acc >( node );
+                n       = &_sh_merge< T, Acc >( r, other, comp );
+        } else {
+                n = &other;
+        }
+        ZLL_ASSERT( n );
+        _attach_right< T, Acc >( node, *n );
+        _sh_count< T, Acc >( other, true );
+}
+
+/// Unlinks `node` like `detach`, but does not update statistics of the heap.
+template < typename T, typename Acc, typename Compare >
+void _sh_detach( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
+{
+        ZLL_INSTRUMENT( T, instr_event::detach, 1 );
+
+        T* n = nullptr;
+        if ( Acc::get( node ).left && Acc::get( node ).right ) {
+                auto& l = _detach_left< T, Acc >( node );
+                auto& r = _detach_right< T, Acc >( node );
+                n       = &_sh_merge< T, Acc >( l, r, comp );
+        } else if ( Acc::get( node ).left ) {
+                n = &_detach_left< T, Acc >( node );
+        } else if ( Acc::get( node ).right ) {
+                n = &_detach_right< T, Acc >( node );
+        }
+        if ( n )
+                _replace_in_parent< T, Acc >( node, *n );
+        else
+                _detach_parent< T, Acc >( node );
+}
+
+/// Unlink a node from the heap. If the node has two children, they are merged using `comp` and the
+/// result is linked to the parent of the detached node. If the node has one child, that child is
+/// linked to the parent of the detached node. If the node has no children, the parent pointer is
+/// set to nullptr.
+template < typename T, typename Acc = typename T::access, typename Compare >
+requires( _provides_sh_header< T, Acc > )
+void detach( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
+{
+        _sh_count< T, Acc >( node, false );
+        _sh_detach< T, Acc >( node, comp );
+}
+
+/// Returns the parent of `n`, `n` has to be a descendant of the node whose subtree is traversed.
+template < typename T, typename Acc >
+T& _sh_parent( T& n ) noexcept( _nothrow_access< Acc, T > )
+{
+        T* p = _node( Acc::get( n ).parent );
+        ZLL_ASSERT( p );
+        return *p;
+}
+
+/// Traverse the heap in-order and call `f` for each node. The order of the nodes is: left child,
+/// node, right child. Walk is iterative, it climbs back through parent pointers, so the depth of
+/// the heap is not limited by the stack and nothing is allocated.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+void inorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
+{
+        T* c = &n;
+        for ( ;; ) {
+                while ( T* l = Acc::get( *c ).left )
+                        c = l;
+                for ( ;; ) {
+                        f( *c );
+                        if ( T* r = Acc::get( *c ).right ) {
+                                c = r;
+                                break;
+                        }
+                        // climb until `c` is reached from the left, its right subtree is next
+                        for ( ;; ) {
+                                if ( c == &n )
+                                        return;
+                                T& p = _sh_parent< T, Acc >( *c );
+                                bool from_left = Acc::get( p ).left == c;
+                                c              = &p;
+                                if ( from_left )
+                                        break;
+                        }
+                }
+        }
+}
+
+/// Traverse the heap pre-order and call `f` for each node. The order of the nodes is: node, left
+/// child, right child. Walk is iterative, see `inorder_traverse`.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+void preorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
+{
+        T* c = &n;
+        for ( ;; ) {
+                f( *c );
+                auto& h = Acc::get( *c );
+                if ( h.left ) {
+                        c = h.left;
+                        continue;
+                }
+                if ( h.right ) {
+                        c = h.right;
+                        continue;
+                }
+                // climb until a node with unvisited right subtree is found
+                for ( ;; ) {
+                        if ( c == &n )
+                                return;
+                        T&    p  = _sh_parent< T, Acc >( *c );
+                        auto& ph = Acc::get( p );
+                        if ( ph.left == c && ph.right ) {
+                                c = ph.right;
+                                break;
+                        }
+                        c = &p;
+                }
+        }
+}
+
+/// Returns the first node of post-order walk of subtree of `n`.
+template < typename T, typename Acc >
+T* _sh_postorder_first( T* n ) noexcept( _nothrow_access< Acc, T > )
+{
+        for ( ;; ) {
+                auto& h = Acc::get( *n );
+                if ( h.left )
+                        n = h.left;
+                else if ( h.right )
+                        n = h.right;
+                else
+                        return n;
+        }
+}
+
+/// Traverse the heap post-order and call `f` for each node. The order of the nodes is: left child,
+/// right child, node. Walk is iterative, see `inorder_traverse`. Successor of each node is found
+/// before `f` is called, so `f` may detach or destroy the node it is called with.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+void postorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
+{
+        T* c = _sh_postorder_first< T, Acc >( &n );
+        for ( ;; ) {
+                if ( c == &n ) {
+                        f( *c );
+                        return;
+                }
+                T&    p    = _sh_parent< T, Acc >( *c );
+                auto& ph   = Acc::get( p );
+                T*    next =
+                    ph.left == c && ph.right ? _sh_postorder_first< T, Acc >( ph.right ) : &p;
+                f( *c );
+                c = next;
+        }
+}
+
+/// Returns successor of `n` in pre-order walk of the whole heap, climbs up through parent pointers
+/// instead of keeping a stack. Returns nullptr for the last node.
+template < typename T, typename Acc >
+T* _sh_preorder_next( T* n ) noexcept( _nothrow_access< Acc, std::remove_const_t< T > > )
+{
+        auto& h = Acc::get( *n );
+        if ( h.left )
+                return h.left;
+        if ( h.right )
+                return h.right;
+        for ( ;; ) {
+                T* p = _node( Acc::get( *n ).parent );
+                if ( !p )
+                        return nullptr;
+                auto& ph = Acc::get( *p );
+                if ( ph.left == n && ph.right )
+                        return ph.right;
+                n = p;
+        }
+}
+
+/// Forward iterator over all nodes of `sh_heap` in pre-order, the top is the first node. Needs
+/// no auxiliary storage. Type `T` is const for const iteration.
+template < typename T, typename Acc = typename std::remove_const_t< T >::access >
+struct sh_iterator
+{
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::remove_const_t< T >;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T*;
+        using reference         = T&;
+
+        sh_iterator() noexcept = default;
+
+        constexpr sh_iterator( T* n ) noexcept
+          : _n( n )
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+                ZLL_ASSERT( _n );
+                return *_n;
+        }
+
+        pointer operator->() const noexcept
+        {
+                ZLL_ASSERT( _n );
+                return _n;
+        }
+
+        sh_iterator& operator++() noexcept
+        {
+                ZLL_INSTRUMENT( value_type, instr_event::iter_step, 1 );
+                if ( _n )
+                        _n = _sh_preorder_next< T, Acc >( _n );
+                return *this;
+        }
+
+        sh_iterator operator++( int ) noexcept
+        {
+                sh_iterator tmp = *this;
+                ++( *this );
+                return tmp;
+        }
+
+        constexpr bool operator==( sh_iterator const& other ) const noexcept
+        {
+                return _n == other._n;
+        }
+
+        constexpr bool operator==( std::default_sentinel_t ) const noexcept
+        {
+                return !_n;
+        }
+
+        T* get() const noexcept
+        {
+                return _n;
+        }
+
+private:
+        T* _n = nullptr;
+};
+
+/// Link a detached node `n2` to the parent of `n1`. Maintains the heap property using `comp`. The
+/// `n2` node must be detached before calling this function.
+template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
+requires( _provides_sh_header< T, Acc > )
+void link_detached( T& n1, T& n2, Compare&& comp = std::less<>{} ) noexcept(
+    _nothrow_access_compare< Acc, T, Compare > )
+{
+        ZLL_ASSERT( ( detached< T, Acc >( n2 ) ) );
+
+        auto p = _detach_parent< T, Acc >( n1 );
+
+        auto& n = _sh_merge< T, Acc >( n1, n2, comp );
+        _attach_parent( n, p );
+        _sh_count< T, Acc >( n2, true );
+}
+
+/// Returns the top node of the heap that `node` is in. The top node is the node that has no parent
+/// and is an ancestor of `node`. If `node` is detached, it is returned.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_sh_header< T, Acc > )
+T& top_node_of( T& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto* n = &node;
+        for ( auto p = Acc::get( node ).parent; p; p = Acc::get( *n ).parent )
+                if ( auto* k = _node( p ) )
+                        n = k;
+                else
+                        break;
+        return *n;
+}
+
+template < typename T, typename Acc, typename Compare >
+requires( _provides_sh_header< T, Acc > )
+T* _sh_pop( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
+{
+        auto& h = Acc::get( node );
+        T*    n = nullptr;
+        if ( h.left && h.right ) {
+                auto& l = _detach_left< T, Acc >( node );
+                auto& r = _detach_right< T, Acc >( node );
+                n       = &_sh_merge< T, Acc >( l, r, comp );
+        } else if ( h.left ) {
+                n = &_detach_left< T, Acc >( node );
+        } else if ( h.right ) {
+                n = &_detach_right< T, Acc >( node );
+        }
+        return n;
+}
+
+/// Predicate used by `sh_heap::drain_le`, true for nodes not greater than `key`.
+template < typename K, typename Compare >
+struct _sh_le
+{
+        K const& key;
+        Compare& comp;
+
+        template < typename T >
+        bool operator()( T const& n ) const noexcept( noexcept( comp( key, n ) ) )
+        {
+                return !comp( key, n );
+        }
+};
+
+/// Stores `next` into `parent` pointer of detached root `n`, used to chain roots without
+/// allocation.
+template < typename T, typename Acc >
+void _sh_link_chain( T& n, T* next ) noexcept( _nothrow_access< Acc, T > )
+{
+        if ( next )
+                Acc::get( n ).parent = *next;
+        else
+                Acc::get( n ).parent = nullptr;
+}
+
+/// Merges chain of detached roots [first, last] linked through `parent` pointers in pairwise
+/// rounds, returns root of the resulting tree.
+template < typename T, typename Acc, typename Compare >
+T& _sh_merge_chain( T& first, T& last, Compare&& comp ) noexcept(
+    _nothrow_access_compare< Acc, T, Compare > )
+{
+        T* f = &first;
+        T* l = &last;
+        while ( f != l ) {
+                T* a = f;
+                T* b = _node( Acc::get( *a ).parent );
+                f    = _node( Acc::get( *b ).parent );
+                Acc::get( *a ).parent = nullptr;
+                Acc::get( *b ).parent = nullptr;
+
+                T& m = _sh_merge< T, Acc >( *a, *b, comp );
+                if ( f ) {
+                        Acc::get( *l ).parent = m;
+                        l                     = &m;
+                } else {
+                        f = &m;
+                        l = &m;
+                }
+        }
+        Acc::get( *f ).parent = nullptr;
+        return *f;
+}
+
+/// Skew heap header containing pointers to left and right children and to the parent node or heap.
+/// Will detach itself from the heap on destruction.
+///
+/// Type `T` is the type of the node that contains the header.
+/// Type `Acc` is the access type that provides access to the header of the node.
+template < typename T, typename Acc, typename Compare, typename Stats >
+struct sh_header
+{
+        T*                                left   = nullptr;
+        T*                                right  = nullptr;
+        _sh_ptr< T, Acc, Compare, Stats > parent = nullptr;
+
+        sh_header() noexcept                         = default;
+        sh_header( sh_header const& )                = delete;
+        sh_header( sh_header&& ) noexcept            = delete;
+        sh_header& operator=( sh_header const& )     = delete;
+        sh_header& operator=( sh_header&& ) noexcept = delete;
+};
+
+/// CRTP base class for skew heap nodes containing `sh_header`. Provides access type to the header
+/// of the node and implements move and copy semantics for the node. Provides basic API for the node
+///
+/// Type `Stats` selects statistics policy of the heap the node is linked into, see `sh_stats`.
+template < typename Derived, typename Compare = std::less<>, typename Stats = sh_no_stats >
+struct sh_base
+{
+        struct access
+        {
+                static auto& get( Derived& d ) noexcept
+                {
+                        return static_cast< sh_base* >( &d )->_hdr;
+                }
+
+                static auto& get( Derived const& d ) noexcept
+                {
+                        return static_cast< sh_base const* >( &d )->_hdr;
+                }
+        };
+
+        sh_base() noexcept = default;
+
+        sh_base( sh_base&& o ) noexcept
+        {
+                move_from_to< Derived, access >( o.derived(), derived() );
+        }
+
+        sh_base& operator=( sh_base&& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                detach< Derived, access >( derived(), _comp );
+                move_from_to< Derived, access >( o.derived(), derived() );
+                return *this;
+        }
+
+        sh_base( sh_base& o ) noexcept
+        {
+                _sh_link_copy< Derived, access >( o.derived(), derived() );
+        }
+
+        sh_base& operator=( sh_base& o ) noexcept
+        {
+                if ( this == &o )
+                        return *this;
+                detach< Derived, access >( derived(), _comp );
+                _sh_link_copy< Derived, access >( o.derived(), derived() );
+                return *this;
+        }
+
+        ~sh_base() noexcept
+        {
+                if ( !detached< Derived, access >( derived() ) )
+                        ZLL_PROBE1( sh_unlink, &derived() );
+                detach< Derived, access >( derived(), _comp );
+        }
+
+protected:
+        Derived& derived() noexcept
+        {
+                return *static_cast< Derived* >( this );
+        }
+
+        Derived const& derived() const noexcept
+        {
+                return *static_cast< Derived const* >( this );
+        }
+
+private:
+        sh_header< Derived, access, Compare, Stats > _hdr;
+        [[no_unique_address]] Compare                _comp;
+};
+
+/// Skew heap implementation. Provides API for linking and merging nodes, merging and popping the
+/// heap, checking if the heap is empty and accessing the top node of the heap. The top node is the
+/// node with the smallest value in the heap according to the comparison function `Compare`.
+///
+/// Type `Stats` is statistics policy, `sh_no_stats` keeps nothing and costs nothing, `sh_stats`
+/// keeps the number of nodes and `sh_debug_stats` also shape statistics of the heap.
+template < typename T, typename Acc, typename Compare, typename Stats >
+struct sh_heap
+{
+        using value_type     = T;
+        using iterator       = sh_iterator< T, Acc >;
+        using const_iterator = sh_iterator< T const, Acc >;
+
+        static constexpr bool noexcept_access = _nothrow_access< Acc, T >;
+
+        sh_heap() noexcept                   = default;
+        sh_heap( sh_heap const& )            = delete;
+        sh_heap& operator=( sh_heap const& ) = delete;
+
+        /// Constructs a heap with the given comparison function. The comparison function is used to
+        /// maintain the heap property when linking and merging nodes. The top node of the heap is
+        /// the node with the smallest value according to the comparison function.
+        sh_heap( Compare comp )
+          : _comp( std::move( comp ) )
+        {
+        }
+
+        /// Move constructor, moved-from heap becomes empty. If top node is present in the
+        /// moved-from heap, it is detached and attached to the new heap.
+        sh_heap( sh_heap&& other ) noexcept
+          : stats( std::exchange( other.stats, Stats{} ) )
+          , _comp( std::move( other._comp ) )
+        {
+                if ( other.top ) {
+                        auto& n = _detach_top( other );
+                        _attach_top( *this, n );
+                }
+        }
+
+        /// Move assignment operator, moved-from heap becomes empty. If top node is present in the
+        /// moved-from heap, it is detached and attached to the new heap. If the current heap has
+        /// a top node, it is detached before attaching the new top node.
+        sh_heap& operator=( sh_heap&& other ) noexcept
+        {
+                if ( this == &other )
+                        return *this;
+                stats = std::exchange( other.stats, Stats{} );
+                _comp = std::move( other._comp );
+                if ( top )
+                        _detach_top( *this );
+                if ( other.top ) {
+                        auto& n = _detach_top( other );
+                        _attach_top( *this, n );
+                }
+                return *this;
+        }
+
+        /// Constructs a heap from an initializer list of nodes. All nodes in the initializer list
+        /// must be detached. The nodes are linked together to form the heap using the comparison
+        /// function `Compare`.
+        sh_heap( std::initializer_list< T* > il ) noexcept( noexcept_access )
+        {
+                // XXX: well, this could be more optimal
+                for ( auto* n : il ) {
+                        ZLL_ASSERT( n );
+                        ZLL_ASSERT( ( detached< T, Acc >( *n ) ) );
+                        link( *n );
+                }
+        }
+
+        /// Iterator over all nodes of the heap in pre-order, the top node first. Order of the other
+        /// nodes is unspecified with respect to the comparison. The heap must not be modified
+        /// during the iteration.
+        iterator begin() noexcept
+        {
+                return iterator{ top };
+        }
+
+        const_iterator begin() const noexcept
+        {
+                return const_iterator{ top };
+        }
+
+        iterator end() noexcept
+        {
+                return iterator{ nullptr };
+        }
+
+        const_iterator end() const noexcept
+        {
+                return const_iterator{ nullptr };
+        }
+
+        /// Destructor, detaches the top node if present.
+        ~sh_heap() noexcept( noexcept_access )
+        {
+                if ( top )
+                        _detach_top( *this );
+        }
+
+        /// Links the node `node` into the heap. The node must be detached before calling this
+        /// function. The heap property is maintained using the comparison function `Compare`.
+        void link( T& node ) noexcept( noexcept_access )
+        {
+                _stats_begin();
+                T* n = nullptr;
+                if ( top ) {
+                        auto& f = _detach_top( *this );
+                        n       = &_sh_merge< T, Acc >( f, node, _stats_comp() );
+                } else {
+                        n = &node;
+                }
+                _attach_top( *this, *n );
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        ++stats.size;
+                _stats_end();
+                ZLL_PROBE2( sh_link, &node, this );
+        }
+
+        /// Merges the `other` heap into this heap. The `other` heap becomes empty after this
+        /// operation. The heap property is maintained using the comparison function `Compare`.
+        void merge( sh_heap&& other ) noexcept
+        {
+                if ( this == &other || other.empty() )
+                        return;
+                if ( empty() ) {
+                        *this = std::move( other );
+                        return;
+                }
+                _stats_begin();
+                auto& l      = _detach_top( *this );
+                auto& r      = _detach_top( other );
+                auto& merged = _sh_merge< T, Acc >( l, r, _stats_comp() );
+                _attach_top( *this, merged );
+                other.top = nullptr;
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        stats.size += std::exchange( other.stats.size, 0 );
+                _stats_end();
+                ZLL_PROBE1( sh_merge, this );
+        }
+
+        /// Returns true if the heap is empty, i.e. contains no nodes.
+        constexpr bool empty() const noexcept
+        {
+                return !top;
+        }
+
+        /// Unlinks the top node from the heap and returns it. The new top node is determined by
+        /// merging the left and right children of the detached top node. Undefined behavior if the
+        /// heap is empty.
+        void pop() noexcept( noexcept_access )
+        {
+                ZLL_ASSERT( top );
+                _stats_begin();
+                auto& t = _detach_top( *this );
+                top     = _sh_pop< T, Acc >( t, _stats_comp() );
+                if ( top )
+                        Acc::get( *top ).parent = *this;
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        --stats.size;
+                _stats_end();
+                ZLL_PROBE2( sh_pop, &t, this );
+        }
+
+        /// Unlinks and returns the top node from the heap. The new top node is determined as if
+        /// `top` is used.
+        T& take() noexcept( noexcept_access )
+        {
+                ZLL_ASSERT( top );
+                T& n = *top;
+                pop();
+                return n;
+        }
+
+        /// Unlinks `node`, which has to be linked in this heap, its children are merged in its
+        /// place. Unlike free `detach` this does not walk up to the heap to update its statistics.
+        void detach( T& node ) noexcept( noexcept_access )
+        {
+                _stats_begin();
+                _sh_detach< T, Acc >( node, _stats_comp() );
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        --stats.size;
+                _stats_end();
+        }
+
+        /// Unlinks all nodes for which `p` returns true and calls `f` for each of them once the
+        /// heap is consistent again, nodes are passed in no particular order. Traversal does not
+        /// descend below nodes for which `p` returns false, hence `p` should be monotone with
+        /// respect to `Compare` - for example check of expired deadline. Subtrees left in the heap
+        /// are merged together in pairwise rounds. Returns the number of unlinked nodes.
+        ///
+        /// Unlinking k nodes costs O(k) plus the merges of remaining subtrees, instead of k pops.
+        template < typename Pred, typename F >
+        requires( std::invocable< F&, T& > )
+        std::size_t take_while( Pred&& p, F&& f ) noexcept(
+            noexcept_access && noexcept( p( *top ) ) && noexcept( f( *top ) ) )
+        {
+                if ( !top || !p( *top ) )
+                        return 0;
+                _stats_begin();
+
+                // Nodes are threaded through their `parent` pointers: `stack` holds unlinked nodes
+                // with not yet visited children, `done` holds fully processed unlinked nodes and
+                // `frontier` roots of subtrees that stay in the heap.
+                T*          stack = &_detach_top( *this );
+                T*          done  = nullptr;
+                T*          first = nullptr;
+                T*          last  = nullptr;
+                std::size_t count = 0;
+                while ( stack ) {
+                        auto& h = Acc::get( *stack );
+                        T*    c = nullptr;
+                        if ( h.left )
+                                c = &_detach_left< T, Acc >( *stack );
+                        else if ( h.right )
+                                c = &_detach_right< T, Acc >( *stack );
+
+                        if ( !c ) {
+                                T* n  = stack;
+                                stack = _node( h.parent );
+                                _sh_link_chain< T, Acc >( *n, done );
+                                done = n;
+                                ++count;
+                        } else if ( p( *c ) ) {
+                                Acc::get( *c ).parent = *stack;
+                                stack                 = c;
+                        } else {
+                                if ( last )
+                                        Acc::get( *last ).parent = *c;
+                                else
+                                        first = c;
+                                last = c;
+                        }
+                }
+
+                if ( first ) {
+                        T& n = _sh_merge_chain< T, Acc >( *first, *last, _stats_comp() );
+                        _attach_top( *this, n );
+                }
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        stats.size -= count;
+                _stats_end( false );
+
+                while ( done ) {
+                        T* n = done;
+                        done = _node( Acc::get( *n ).parent );
+                        Acc::get( *n ).parent = nullptr;
+                        f( *n );
+                }
+                return count;
+        }
+
+        /// Unlinks all nodes for which `p` returns true and links them at the back of `out`, see
+        /// `take_while` above for details.
+        template < typename Pred, typename LAcc >
+        std::size_t take_while( Pred&& p, ll_list< T, LAcc >& out ) noexcept(
+            noexcept_access && _nothrow_access< LAcc, T > && noexcept( p( *top ) ) )
+        {
+                auto link = [&out]( T& n ) noexcept( _nothrow_access< LAcc, T > ) {
+                        out.link_back( n );
+                };
+                return take_while( std::forward< Pred >( p ), link );
+        }
+
+        /// Unlinks all nodes for which `p` returns true and calls `f` for each of them once the
+        /// heap is consistent again, nodes are passed in no particular order. Unlike `take_while`
+        /// the predicate needs no relation to `Compare`, whole heap is walked once without
+        /// recursion. Children of unlinked nodes become roots of orphaned subtrees, these and the
+        /// remaining tree are merged together in pairwise rounds. Returns the number of unlinked
+        /// nodes.
+        ///
+        /// Costs O(n) plus the merges of orphaned subtrees, instead of `detach` per node.
+        template < typename Pred, typename F >
+        requires( std::invocable< F&, T& > )
+        std::size_t remove_if( Pred&& p, F&& f ) noexcept(
+            noexcept_access && noexcept( p( *top ) ) && noexcept( f( *top ) ) )
+        {
+                if ( !top )
+                        return 0;
+                _stats_begin();
+
+                // Nodes are threaded through their `parent` pointers: `todo` holds detached roots
+                // not yet examined, `done` unlinked nodes and [first, last] roots of kept subtrees.
+                T*          todo  = &_detach_top( *this );
+                T*          done  = nullptr;
+                T*          first = nullptr;
+                T*          last  = nullptr;
+                std::size_t count = 0;
+                auto        cut   = [&]( T& n ) {
+                        auto& h = Acc::get( n );
+                        for ( T* c : { h.left, h.right } ) {
+                                if ( !c )
+                                        continue;
+                                _detach_parent< T, Acc >( *c );
+                                _sh_link_chain< T, Acc >( *c, todo );
+                                todo = c;
+                        }
+                        _sh_link_chain< T, Acc >( n, done );
+                        done = &n;
+                        ++count;
+                };
+                while ( todo ) {
+                        T* r = todo;
+                        todo = _node( Acc::get( *r ).parent );
+                        Acc::get( *r ).parent = nullptr;
+                        if ( p( *r ) ) {
+                                cut( *r );
+                                continue;
+                        }
+
+                        // pre-order walk of kept subtree, matching children are cut before the
+                        // walk descends, so it climbs back only through kept nodes
+                        T* c = r;
+                        for ( ;; ) {
+                                auto& h = Acc::get( *c );
+                                if ( h.left && p( *h.left ) )
+                                        cut( _detach_left< T, Acc >( *c ) );
+                                if ( h.right && p( *h.right ) )
+                                        cut( _detach_right< T, Acc >( *c ) );
+                                if ( T* n = h.left ? h.left : h.right ) {
+                                        c = n;
+                                        continue;
+                                }
+                                while ( c != r ) {
+                                        T&    pa = _sh_parent< T, Acc >( *c );
+                                        auto& ph = Acc::get( pa );
+                                        if ( ph.left == c && ph.right ) {
+                                                c = ph.right;
+                                                break;
+                                        }
+                                        c = &pa;
+                                }
+                                if ( c == r )
+                                        break;
+                        }
+
+                        if ( last )
+                                Acc::get( *last ).parent = *r;
+                        else
+                                first = r;
+                        last = r;
+                }
+
+                if ( first ) {
+                        T& n = _sh_merge_chain< T, Acc >( *first, *last, _stats_comp() );
+                        _attach_top( *this, n );
+                }
+                if constexpr ( _sh_counts_nodes< Stats > )
+                        stats.size -= count;
+                _stats_end( false );
+
+                while ( done ) {
+                        T* n = done;
+                        done = _node( Acc::get( *n ).parent );
+                        Acc::get( *n ).parent = nullptr;
+                        f( *n );
+                }
+                return count;
+        }
+
+        /// Unlinks all nodes for which `p` returns true and links them at the back of `out`, see
+        /// `remove_if` above for details.
+        template < typename Pred, typename LAcc >
+        std::size_t remove_if( Pred&& p, ll_list< T, LAcc >& out ) noexcept(
+            noexcept_access && _nothrow_access< LAcc, T > && noexcept( p( *top ) ) )
+        {
+                auto link = [&out]( T& n ) noexcept( _nothrow_access< LAcc, T > ) {
+                        out.link_back( n );
+                };
+                return remove_if( std::forward< Pred >( p ), link );
+        }
+
+        /// Unlinks all nodes that are not greater than `key` according to `Compare` and passes
+        /// them to `out`, which is either callable or `ll_list`. See `take_while` for details.
+        template < typename K, typename Out >
+        std::size_t drain_le( K const& key, Out&& out ) noexcept(
+            noexcept( take_while( std::declval< _sh_le< K, Compare > >(), out ) ) )
+        {
+                return take_while( _sh_le< K, Compare >{ key, _comp }, std::forward< Out >( out ) );
+        }
+
+        /// Calls `f` for up to `buf.size()` smallest nodes of the heap in sorted order, without
+        /// modifying the heap. Children of a node are never smaller than the node, so the walk
+        /// keeps a frontier of candidates in `buf` organized as binary heap and expands the best
+        /// one. Each delivered node adds at most one candidate, hence `buf.size()` entries suffice.
+        /// Returns the number of delivered nodes.
+        ///
+        /// Costs O(k log k) for k delivered nodes, regardless of the size of the heap.
+        template < typename F >
+        requires( std::invocable< F&, T const& > )
+        std::size_t peek_sorted( std::span< T const* > buf, F&& f ) const noexcept(
+            noexcept_access && noexcept( _comp( *top, *top ) ) && noexcept( f( *top ) ) )
+        {
+                std::size_t const k = buf.size();
+                if ( !top || k == 0 )
+                        return 0;
+                auto later = [this]( T const* a, T const* b ) {
+                        return _comp( *b, *a );
+                };
+                std::size_t n     = 0;
+                std::size_t count = 0;
+                buf[n++]          = top;
+                while ( n > 0 ) {
+                        std::pop_heap( buf.data(), buf.data() + n, later );
+                        T const& c = *buf[--n];
+                        if ( ++count < k ) {
+                                auto& h = Acc::get( c );
+                                for ( T const* ch : { h.left, h.right } ) {
+                                        if ( !ch )
+                                                continue;
+                                        buf[n++] = ch;
+                                        std::push_heap( buf.data(), buf.data() + n, later );
+                                }
+                        }
+                        f( c );
+                        if ( count == k )
+                                break;
+                }
+                return count;
+        }
+
+        /// Calls `f` for up to `K` smallest nodes in sorted order, frontier is stored in a local
+        /// array. See `peek_sorted` above.
+        template < std::size_t K, typename F >
+        requires( std::invocable< F&, T const& > )
+        std::size_t peek_sorted( F&& f ) const noexcept(
+            noexcept_access && noexcept( _comp( *top, *top ) ) && noexcept( f( *top ) ) )
+        {
+                std::array< T const*, K > buf;
+                return peek_sorted( std::span< T const* >{ buf }, f );
+        }
+
+        /// Returns the number of nodes in the heap, available only if `Stats` counts nodes.
+        std::size_t size() const noexcept
+        requires( _sh_counts_nodes< Stats > )
+        {
+                return stats.size;
+        }
+
+        T*                          top = nullptr;
+        [[no_unique_address]] Stats stats{};
+
+private:
+        /// Returns comparator used for merges, counts merge steps if `Stats` asks for it.
+        decltype( auto ) _stats_comp() noexcept
+        {
+                if constexpr ( _sh_counts_steps< Stats > ) {
+                        return [this]( auto& a, auto& b ) noexcept( noexcept( _comp( a, b ) ) ) {
+                                ++stats.last_merge_steps;
+                                return _comp( a, b );
+                        };
+                } else {
+                        return ( _comp );
+                }
+        }
+
+        void _stats_begin() noexcept
+        {
+                if constexpr ( _sh_counts_steps< Stats > )
+                        stats.last_merge_steps = 0;
+        }
+
+        /// Records merge steps of finished operation, `single_merge` tells that all steps belong
+        /// to one merge path.
+        void _stats_end( bool single_merge = true ) noexcept
+        {
+                if constexpr ( _sh_counts_steps< Stats > ) {
+                        if ( stats.last_merge_steps > stats.max_merge_steps )
+                                stats.max_merge_steps = stats.last_merge_steps;
+                        if ( single_merge && stats.last_merge_steps > stats.max_right_spine )
+                                stats.max_right_spine = stats.last_merge_steps;
+                } else {
+                        (void) single_merge;
+                }
+        }
+
+        [[no_unique_address]] Compare _comp{};
+};
+
+template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
+struct lh_header;
+
+template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
+struct lh_heap;
+
+template < typename H >
+struct _is_lh_header : std::false_type
+{
+};
+
+template < typename T, typename Acc, typename Compare >
+struct _is_lh_header< lh_header< T, Acc, Compare > > : std::true_type
+{
+};
+
+template < typename T, typename Acc >
+concept _provides_lh_header = requires( T& t ) {
+        requires _is_lh_header< std::remove_cvref_t< decltype( Acc::get( t ) ) > >::value;
+};
+
+template < typename T, typename Acc, typename Compare = std::less<> >
+using _lh_ptr = _vptr< T, lh_heap< T, Acc, Compare >, 1 >;
+
+template < typename T, typename Acc, typename Compare >
+auto* _node( _lh_ptr< T, Acc, Compare > p ) noexcept
+{
+        return p.a();
+}
+
+template < typename T, typename Acc, typename Compare >
+auto* _heap( _lh_ptr< T, Acc, Compare > p ) noexcept
+{
+        return p.b();
+}
+
+template < typename T, typename Acc, typename Compare >
+T& _detach_top( lh_heap< T, Acc, Compare >& parent ) noexcept( _nothrow_access< Acc, T > )
+{
+        T& tmp                 = *parent.top;
+        Acc::get( tmp ).parent = nullptr;
+        parent.top             = nullptr;
+        return tmp;
+}
+
+template < typename T, typename Acc, typename Compare >
+void _attach_top( lh_heap< T, Acc, Compare >& parent, T& node ) noexcept(
+    _nothrow_access< Acc, T > )
+{
+        parent.top              = &node;
+        Acc::get( node ).parent = parent;
+}
+
+/// Leftist heap header containing pointers to left and right children, to the parent node or heap
+/// and rank of the node - the length of the right spine of the subtree rooted in the node.
+///
+/// Type `T` is the type of the node that contains the header.
+/// Type `Acc` is the access type that provides access to the header of the node.
+template < typename T, typename Acc, typename Compare >
+struct lh_header
+{
+        T*                         left   = nullptr;
+        T*                         right  = nullptr;
+        _lh_ptr< T, Acc, Compare > parent = nullptr;
+        std::uint8_t               rank   = 1;
+
+        lh_header() noexcept                         = default;
+        lh_header( lh_header const& )                = delete;
+        lh_header( lh_header&& ) noexcept            = delete;
+        lh_header& operator=( lh_header const& )     = delete;
+        lh_header& operator=( lh_header&& ) noexcept = delete;
+};
+
+template < typename T, typename Acc >
+std::uint8_t _lh_rank( T const* n ) noexcept( _nothrow_access< Acc, T > )
+{
+        return n ? Acc::get( *n ).rank : 0;
+}
+
+/// Restores the leftist property of `n` assuming both subtrees are leftist. Returns true if the
+/// rank of `n` changed.
+template < typename T, typename Acc >
+bool _lh_fix( T& n ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto& h = Acc::get( n );
+        if ( _lh_rank< T, Acc >( h.left ) < _lh_rank< T, Acc >( h.right ) )
+                std::swap( h.left, h.right );
+        auto r = static_cast< std::uint8_t >( _lh_rank< T, Acc >( h.right ) + 1 );
+        if ( r == h.rank )
+                return false;
+        h.rank = r;
+        return true;
+}
+
+/// Merges two detached leftist trees, recursion follows only right spines of both trees and hence
+/// is bounded by O(log n).
+template < typename T, typename Acc, typename Compare >
+T& _lh_merge( T& left, T& right, Compare&& comp ) noexcept(
+    _nothrow_access_compare< Acc, T, Compare > )
+{
+        ZLL_INSTRUMENT( T, instr_event::merge_step, 1 );
+        ZLL_ASSERT( !Acc::get( left ).parent );
+        ZLL_ASSERT( !Acc::get( right ).parent );
+
+        T* a = &left;
+        T* b = &right;
+        if ( comp( *b, *a ) )
+                std::swap( a, b );
+
+        if ( Acc::get( *a ).right ) {
+                auto& a_right = _detach_right< T, Acc >( *a );
+                auto& m       = _lh_merge< T, Acc >( a_right, *b, comp );
+                _attach_right< T, Acc >( *a, m );
+        } else {
+                _attach_right< T, Acc >( *a, *b );
+        }
+        _lh_fix< T, Acc >( *a );
+        return *a;
+}
+
+/// Returns true if the node is detached from heap.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_lh_header< T, Acc > )
+bool detached( T& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto& n_hdr = Acc::get( node );
+        return !n_hdr.left && !n_hdr.right && !n_hdr.parent;
+}
+
+/// Returns user flag stored in spare bit of the header of `node`, one flag is available. The flag
+/// belongs to the node: it is kept while the node is linked or detached and `move_from_to` does
+/// not transfer it.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_lh_header< T, Acc > )
+std::uintptr_t node_flags( T const& node ) noexcept( _nothrow_access< Acc, T > )
 {
-        auto& parent = Acc::get( node ).parent;
-
-        if ( auto* n = _node( parent ) ) {
-                if ( Acc::get( *n ).left == &node )
-                        _attach_left< T, Acc >( *n, new_node );
-                else if ( Acc::get( *n ).right == &node )
-                        _attach_right< T, Acc >( *n, new_node );
-        } else if ( auto* h = _heap( parent ) ) {
-                _attach_top( *h, new_node );
-        }
+        return Acc::get( node ).parent.flags();
+}
 
-        parent = nullptr;
+/// Sets user flag stored in spare bit of the header of `node`, see `node_flags`.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_lh_header< T, Acc > )
+void set_node_flags( T& node, std::uintptr_t f ) noexcept( _nothrow_access< Acc, T > )
+{
+        Acc::get( node ).parent.set_flags( f );
 }
 
-/// Links all children from `from` node to `to` node. The `to` node must be detached.
+/// Links all children from `from` node to `to` node, `to` node takes over the position of `from`
+/// node in the heap. The `to` node must be detached.
 template < typename T, typename Acc = typename T::access >
-requires( _provides_sh_header< T, Acc > )
+requires( _provides_lh_header< T, Acc > )
 void move_from_to( T& from, T& to ) noexcept( _nothrow_access< Acc, T > )
 {
-        ZLL_ASSERT( detached( to ) );
+        ZLL_ASSERT( ( detached< T, Acc >( to ) ) );
+        ZLL_INSTRUMENT( T, instr_event::move, 1 );
 
         if ( Acc::get( from ).left ) {
                 auto& l = _detach_left< T, Acc >( from );
@@ -1291,189 +3492,136 @@ void move_from_to( T& from, T& to ) noexcept( _nothrow_access< Acc, T > )
                 auto& r = _detach_right< T, Acc >( from );
                 _attach_right< T, Acc >( to, r );
         }
+        Acc::get( to ).rank   = Acc::get( from ).rank;
+        Acc::get( from ).rank = 1;
         if ( Acc::get( from ).parent )
                 _replace_in_parent< T, Acc >( from, to );
 }
 
-/// Link a detached node `other` to `node`. Maintains the heap property using `comp`. The `other`
-/// node must be detached before calling this function.
+/// Returns the top node of the heap that `node` is in. If `node` is detached, it is returned.
+template < typename T, typename Acc = typename T::access >
+requires( _provides_lh_header< T, Acc > )
+T& top_node_of( T& node ) noexcept( _nothrow_access< Acc, T > )
+{
+        auto* n = &node;
+        while ( auto* p = _node( Acc::get( *n ).parent ) )
+                n = p;
+        return *n;
+}
+
+/// Link a detached node `n2` into the heap that contains `n1`. Maintains the heap property using
+/// `comp`. The `n2` node must be detached before calling this function.
+///
+/// The top node is found by climbing parent pointers, which is O(depth) and the depth of leftist
+/// heap is not bounded by O(log n) - unlike other operations this is not worst-case O(log n).
 template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
-requires( _provides_sh_header< T, Acc > )
-void link_detached_to( T& node, T& other, Compare&& comp = std::less<>{} ) noexcept(
+requires( _provides_lh_header< T, Acc > )
+void link_detached( T& n1, T& n2, Compare&& comp = std::less<>{} ) noexcept(
     _nothrow_access_compare< Acc, T, Compare > )
 {
-        ZLL_ASSERT( detached( other ) );
+        ZLL_ASSERT( ( detached< T, Acc >( n2 ) ) );
 
-        T* n = nullptr;
-        if ( Acc::get( node ).right ) {
-                auto& r = _detach_right< T, Acc >( node );
-                n       = &_sh_merge< T, Acc >( r, other, comp );
-        } else {
-                n = &other;
-        }
-        ZLL_ASSERT( n );
-        _attach_right< T, Acc >( node, *n );
+        auto& t = top_node_of< T, Acc >( n1 );
+        auto* h = _heap( _detach_parent< T, Acc >( t ) );
+
+        auto& n = _lh_merge< T, Acc >( t, n2, comp );
+        if ( h )
+                _attach_top( *h, n );
 }
 
-/// Unlink a node from the heap. If the node has two children, they are merged using `comp` and the
-/// result is linked to the parent of the detached node. If the node has one child, that child is
-/// linked to the parent of the detached node. If the node has no children, the parent pointer is
-/// set to nullptr.
+/// Unlink a node from the heap. Children of the node are merged using `comp` and the result takes
+/// the position of the node. Ranks of ancestors are fixed afterwards, which walks at most the
+/// right spine and hence the operation is worst-case O(log n).
 template < typename T, typename Acc = typename T::access, typename Compare >
-requires( _provides_sh_header< T, Acc, Compare > )
+requires( _provides_lh_header< T, Acc > )
 void detach( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
 {
-        T* n = nullptr;
-        if ( Acc::get( node ).left && Acc::get( node ).right ) {
+        ZLL_INSTRUMENT( T, instr_event::detach, 1 );
+        auto& h = Acc::get( node );
+        T*    n = nullptr;
+        if ( h.left && h.right ) {
                 auto& l = _detach_left< T, Acc >( node );
                 auto& r = _detach_right< T, Acc >( node );
-                n       = &_sh_merge< T, Acc >( l, r, comp );
-        } else if ( Acc::get( node ).left ) {
+                n       = &_lh_merge< T, Acc >( l, r, comp );
+        } else if ( h.left ) {
                 n = &_detach_left< T, Acc >( node );
-        } else if ( Acc::get( node ).right ) {
+        } else if ( h.right ) {
                 n = &_detach_right< T, Acc >( node );
         }
+        h.rank = 1;
+
+        auto* p = _node( h.parent );
         if ( n )
                 _replace_in_parent< T, Acc >( node, *n );
         else
                 _detach_parent< T, Acc >( node );
-}
 
-/// Traverse the heap in-order and call `f` for each node. The order of the nodes is: left child,
-/// node, right child.
-template < typename T, typename Acc = typename T::access >
-requires( _provides_sh_header< T, Acc > )
-void inorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
-{
-        auto& h = Acc::get( n );
-        if ( h.left )
-                inorder_traverse< T, Acc >( *h.left, f );
-        f( n );
-        if ( h.right )
-                inorder_traverse< T, Acc >( *h.right, f );
-}
-
-/// Traverse the heap pre-order and call `f` for each node. The order of the nodes is: node, left
-/// child, right child.
-template < typename T, typename Acc = typename T::access >
-requires( _provides_sh_header< T, Acc > )
-void preorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
-{
-        auto& h = Acc::get( n );
-        f( n );
-        if ( h.left )
-                preorder_traverse< T, Acc >( *h.left, f );
-        if ( h.right )
-                preorder_traverse< T, Acc >( *h.right, f );
-}
-
-/// Traverse the heap post-order and call `f` for each node. The order of the nodes is: left child,
-/// right child, node.
-template < typename T, typename Acc = typename T::access >
-requires( _provides_sh_header< T, Acc > )
-void postorder_traverse( T& n, std::invocable< T& > auto&& f ) noexcept( _nothrow_access< Acc, T > )
-{
-        auto& h = Acc::get( n );
-        if ( h.left )
-                postorder_traverse< T, Acc >( *h.left, f );
-        if ( h.right )
-                postorder_traverse< T, Acc >( *h.right, f );
-        f( n );
-}
-
-/// Link a detached node `n2` to the parent of `n1`. Maintains the heap property using `comp`. The
-/// `n2` node must be detached before calling this function.
-template < typename T, typename Acc = typename T::access, typename Compare = std::less<> >
-requires( _provides_sh_header< T, Acc > )
-void link_detached( T& n1, T& n2, Compare&& comp = std::less<>{} ) noexcept(
-    _nothrow_access_compare< Acc, T, Compare > )
-{
-        ZLL_ASSERT( detached( n2 ) );
-
-        auto p = _detach_parent< T, Acc >( n1 );
-
-        auto& n = _sh_merge< T, Acc >( n1, n2, comp );
-        _attach_parent( n, p );
+        for ( ; p && _lh_fix< T, Acc >( *p ); p = _node( Acc::get( *p ).parent ) )
+                ;
 }
 
-/// Returns the top node of the heap that `node` is in. The top node is the node that has no parent
-/// and is an ancestor of `node`. If `node` is detached, it is returned.
-template < typename T, typename Acc = typename T::access >
-requires( _provides_sh_header< T, Acc > )
-T& top_node_of( T& node ) noexcept( _nothrow_access< Acc, T > )
+/// Links detached `copy` of `node` as right child of `node`, former right subtree of `node` becomes
+/// left subtree of `copy`. The copy is equal to `node`, so no comparison is needed - members of the
+/// copy are not yet copied when called from the copy constructor of the base. Ranks are fixed on
+/// the way up as in `detach`, hence worst-case O(log n).
+template < typename T, typename Acc >
+void _lh_link_copy( T& node, T& copy ) noexcept( _nothrow_access< Acc, T > )
 {
-        auto* n = &node;
-        for ( auto p = Acc::get( node ).parent; p; p = Acc::get( *n ).parent )
-                if ( auto* k = _node( p ) )
-                        n = k;
-                else
-                        break;
-        return *n;
+        ZLL_ASSERT( ( detached< T, Acc >( copy ) ) );
+        if ( Acc::get( node ).right )
+                _attach_left< T, Acc >( copy, _detach_right< T, Acc >( node ) );
+        _lh_fix< T, Acc >( copy );
+        _attach_right< T, Acc >( node, copy );
+        for ( T* p = &node; p && _lh_fix< T, Acc >( *p ); p = _node( Acc::get( *p ).parent ) )
+                ;
 }
 
 template < typename T, typename Acc, typename Compare >
-requires( _provides_sh_header< T, Acc, Compare > )
-T* _sh_pop( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
+requires( _provides_lh_header< T, Acc > )
+T* _lh_pop( T& node, Compare&& comp ) noexcept( _nothrow_access_compare< Acc, T, Compare > )
 {
         auto& h = Acc::get( node );
         T*    n = nullptr;
         if ( h.left && h.right ) {
                 auto& l = _detach_left< T, Acc >( node );
                 auto& r = _detach_right< T, Acc >( node );
-                n       = &_sh_merge< T, Acc >( l, r, comp );
+                n       = &_lh_merge< T, Acc >( l, r, comp );
         } else if ( h.left ) {
                 n = &_detach_left< T, Acc >( node );
-        } else if ( h.right ) {
-                n = &_detach_right< T, Acc >( node );
         }
+        h.rank = 1;
         return n;
 }
 
-/// Skew heap header containing pointers to left and right children and to the parent node or heap.
-/// Will detach itself from the heap on destruction.
-///
-/// Type `T` is the type of the node that contains the header.
-/// Type `Acc` is the access type that provides access to the header of the node.
-template < typename T, typename Acc, typename Compare >
-struct sh_header
-{
-        T*                         left   = nullptr;
-        T*                         right  = nullptr;
-        _sh_ptr< T, Acc, Compare > parent = nullptr;
-
-        sh_header() noexcept                         = default;
-        sh_header( sh_header const& )                = delete;
-        sh_header( sh_header&& ) noexcept            = delete;
-        sh_header& operator=( sh_header const& )     = delete;
-        sh_header& operator=( sh_header&& ) noexcept = delete;
-};
-
-/// CRTP base class for skew heap nodes containing `sh_header`. Provides access type to the header
-/// of the node and implements move and copy semantics for the node. Provides basic API for the node
+/// CRTP base class for leftist heap nodes containing `lh_header`. Provides access type to the
+/// header of the node and implements move and copy semantics for the node. Provides basic API for
+/// the node.
 template < typename Derived, typename Compare = std::less<> >
-struct sh_base
+struct lh_base
 {
         struct access
         {
                 static auto& get( Derived& d ) noexcept
                 {
-                        return static_cast< sh_base* >( &d )->_hdr;
+                        return static_cast< lh_base* >( &d )->_hdr;
                 }
 
                 static auto& get( Derived const& d ) noexcept
                 {
-                        return static_cast< sh_base const* >( &d )->_hdr;
+                        return static_cast< lh_base const* >( &d )->_hdr;
                 }
         };
 
-        sh_base() noexcept = default;
+        lh_base() noexcept = default;
 
-        sh_base( sh_base&& o ) noexcept
+        /// Move constructor, moved-from node is detached. The new node takes over position of the
+        /// moved-from node in the heap.
+        lh_base( lh_base&& o ) noexcept
         {
                 move_from_to< Derived, access >( o.derived(), derived() );
         }
 
-        sh_base& operator=( sh_base&& o ) noexcept
+        lh_base& operator=( lh_base&& o ) noexcept
         {
                 if ( this == &o )
                         return *this;
@@ -1482,21 +3630,24 @@ struct sh_base
                 return *this;
         }
 
-        sh_base( sh_base& o ) noexcept
+        /// Copy constructor, copied node is linked into the heap of the copied node, right below
+        /// it.
+        lh_base( lh_base& o ) noexcept
         {
-                link_detached_to< Derived, access >( o.derived(), derived() );
+                _lh_link_copy< Derived, access >( o.derived(), derived() );
         }
 
-        sh_base& operator=( sh_base& o ) noexcept
+        /// Copy assignment operator, the node is unlinked and linked right below the copied node.
+        lh_base& operator=( lh_base& o ) noexcept
         {
                 if ( this == &o )
                         return *this;
                 detach< Derived, access >( derived(), _comp );
-                link_detached_to< Derived, access >( o.derived(), derived() );
+                _lh_link_copy< Derived, access >( o.derived(), derived() );
                 return *this;
         }
 
-        ~sh_base() noexcept
+        ~lh_base() noexcept
         {
                 detach< Derived, access >( derived(), _comp );
         }
@@ -1513,33 +3664,30 @@ protected:
         }
 
 private:
-        sh_header< Derived, access, Compare > _hdr;
+        lh_header< Derived, access, Compare > _hdr;
         [[no_unique_address]] Compare         _comp;
 };
 
-/// Skew heap implementation. Provides API for linking and merging nodes, merging and popping the
-/// heap, checking if the heap is empty and accessing the top node of the heap. The top node is the
-/// node with the smallest value in the heap according to the comparison function `Compare`.
+/// Leftist heap implementation. Provides the same API as `sh_heap`, but all operations have
+/// worst-case O(log n) complexity instead of amortized one. The price is rank stored in each
+/// header and slightly more work per merge step.
 template < typename T, typename Acc, typename Compare >
-struct sh_heap
+struct lh_heap
 {
         static constexpr bool noexcept_access = _nothrow_access< Acc, T >;
 
-        sh_heap() noexcept                   = default;
-        sh_heap( sh_heap const& )            = delete;
-        sh_heap& operator=( sh_heap const& ) = delete;
+        lh_heap() noexcept                   = default;
+        lh_heap( lh_heap const& )            = delete;
+        lh_heap& operator=( lh_heap const& ) = delete;
 
-        /// Constructs a heap with the given comparison function. The comparison function is used to
-        /// maintain the heap property when linking and merging nodes. The top node of the heap is
-        /// the node with the smallest value according to the comparison function.
-        sh_heap( Compare comp )
+        /// Constructs a heap with the given comparison function.
+        lh_heap( Compare comp )
           : _comp( std::move( comp ) )
         {
         }
 
-        /// Move constructor, moved-from heap becomes empty. If top node is present in the
-        /// moved-from heap, it is detached and attached to the new heap.
-        sh_heap( sh_heap&& other ) noexcept
+        /// Move constructor, moved-from heap becomes empty.
+        lh_heap( lh_heap&& other ) noexcept
           : _comp( std::move( other._comp ) )
         {
                 if ( other.top ) {
@@ -1548,10 +3696,9 @@ struct sh_heap
                 }
         }
 
-        /// Move assignment operator, moved-from heap becomes empty. If top node is present in the
-        /// moved-from heap, it is detached and attached to the new heap. If the current heap has
-        /// a top node, it is detached before attaching the new top node.
-        sh_heap& operator=( sh_heap&& other ) noexcept
+        /// Move assignment operator, moved-from heap becomes empty. If the current heap has a top
+        /// node, it is detached before attaching the new top node.
+        lh_heap& operator=( lh_heap&& other ) noexcept
         {
                 if ( this == &other )
                         return *this;
@@ -1566,11 +3713,9 @@ struct sh_heap
         }
 
         /// Constructs a heap from an initializer list of nodes. All nodes in the initializer list
-        /// must be detached. The nodes are linked together to form the heap using the comparison
-        /// function `Compare`.
-        sh_heap( std::initializer_list< T* > il ) noexcept( noexcept_access )
+        /// must be detached.
+        lh_heap( std::initializer_list< T* > il ) noexcept( noexcept_access )
         {
-                // XXX: well, this could be more optimal
                 for ( auto* n : il ) {
                         ZLL_ASSERT( n );
                         ZLL_ASSERT( ( detached< T, Acc >( *n ) ) );
@@ -1579,63 +3724,57 @@ struct sh_heap
         }
 
         /// Destructor, detaches the top node if present.
-        ~sh_heap() noexcept( noexcept_access )
+        ~lh_heap() noexcept( noexcept_access )
         {
                 if ( top )
                         _detach_top( *this );
         }
 
         /// Links the node `node` into the heap. The node must be detached before calling this
-        /// function. The heap property is maintained using the comparison function `Compare`.
+        /// function.
         void link( T& node ) noexcept( noexcept_access )
         {
-                T* n = nullptr;
+                T* n = &node;
                 if ( top ) {
                         auto& f = _detach_top( *this );
-                        n       = &_sh_merge< T, Acc >( f, node, _comp );
-                } else {
-                        n = &node;
+                        n       = &_lh_merge< T, Acc >( f, node, _comp );
                 }
                 _attach_top( *this, *n );
         }
 
         /// Merges the `other` heap into this heap. The `other` heap becomes empty after this
-        /// operation. The heap property is maintained using the comparison function `Compare`.
-        void merge( sh_heap&& other ) noexcept
+        /// operation.
+        void merge( lh_heap&& other ) noexcept
         {
-                if ( this == &other )
+                if ( this == &other || other.empty() )
                         return;
-                if ( empty() || other.empty() ) {
+                if ( empty() ) {
                         *this = std::move( other );
                         return;
                 }
                 auto& l      = _detach_top( *this );
                 auto& r      = _detach_top( other );
-                auto& merged = _sh_merge< T, Acc >( l, r, _comp );
+                auto& merged = _lh_merge< T, Acc >( l, r, _comp );
                 _attach_top( *this, merged );
-                other.top = nullptr;
         }
 
         /// Returns true if the heap is empty, i.e. contains no nodes.
-        bool empty() const noexcept
+        constexpr bool empty() const noexcept
         {
                 return !top;
         }
 
-        /// Unlinks the top node from the heap and returns it. The new top node is determined by
-        /// merging the left and right children of the detached top node. Undefined behavior if the
-        /// heap is empty.
+        /// Unlinks the top node from the heap. Undefined behavior if the heap is empty.
         void pop() noexcept( noexcept_access )
         {
                 ZLL_ASSERT( top );
                 auto& t = _detach_top( *this );
-                top     = _sh_pop< T, Acc >( t, _comp );
+                top     = _lh_pop< T, Acc >( t, _comp );
                 if ( top )
                         Acc::get( *top ).parent = *this;
         }
 
-        /// Unlinks and returns the top node from the heap. The new top node is determined as if
-        /// `top` is used.
+        /// Unlinks and returns the top node from the heap. Undefined behavior if the heap is empty.
         T& take() noexcept( noexcept_access )
         {
                 ZLL_ASSERT( top );
@@ -1650,4 +3789,183 @@ private:
         [[no_unique_address]] Compare _comp{};
 };
 
+/// Merges all heaps of `hs` into `*hs[0]`, the other heaps become empty. Heaps are merged in
+/// pairwise rounds: neighbours first, then the results of the previous round, so no heap is merged
+/// with a much larger one more than necessary. Works for `sh_heap` and `lh_heap`, nothing is
+/// allocated. Undefined behavior if `hs` is empty.
+template < typename Heap >
+Heap& meld_all( std::span< Heap* > hs ) noexcept
+{
+        ZLL_ASSERT( !hs.empty() );
+        for ( std::size_t step = 1; step < hs.size(); step *= 2 )
+                for ( std::size_t i = 0; i + step < hs.size(); i += 2 * step )
+                        hs[i]->merge( std::move( *hs[i + step] ) );
+        return *hs[0];
+}
+
+/// Merges all sorted lists of `ls` into `*ls[0]`, the other lists become empty. Lists are merged
+/// in pairwise rounds, so each node takes part in O(log k) merges for k lists and nothing is
+/// allocated. Merge is stable: equal nodes keep the order of their lists in `ls`. Undefined
+/// behavior if `ls` is empty.
+template < typename T, typename Acc, typename Compare = std::less<> >
+ll_list< T, Acc >& merge_all( std::span< ll_list< T, Acc >* > ls, Compare comp = {} ) noexcept(
+    _nothrow_access< Acc, T > && noexcept( comp( std::declval< T& >(), std::declval< T& >() ) ) )
+{
+        ZLL_ASSERT( !ls.empty() );
+        for ( std::size_t step = 1; step < ls.size(); step *= 2 )
+                for ( std::size_t i = 0; i + step < ls.size(); i += 2 * step )
+                        ls[i]->merge( std::move( *ls[i + step] ), comp );
+        return *ls[0];
+}
+
+/// Default key extractor of `radix_heap`, expects node to provide `key()` member convertible to
+/// `std::uint64_t`.
+struct rh_key
+{
+        template < typename T >
+        std::uint64_t operator()( T const& n ) const noexcept( noexcept( n.key() ) )
+        {
+                return static_cast< std::uint64_t >( n.key() );
+        }
+};
+
+/// Radix heap implementation for monotone integer priorities. Nodes are stored in buckets
+/// represented by `ll_list`, bucket index is given by the highest bit in which the key of node
+/// differs from the last popped key. Linking is O(1), popping is amortized O(log C) where C is the
+/// range of keys, no comparison of nodes is ever done.
+///
+/// Keys of linked nodes must not be smaller than the last popped key, see `last_key`.
+///
+/// As nodes contain just `ll_header`, they are movable and unlink on destruction as any other node
+/// of `ll_list`.
+///
+/// Type `T` is the type of the node that contains the header.
+/// Type `Acc` specifies how to access the node's header.
+/// Type `KeyFn` is used to extract `std::uint64_t` key from the node.
+template < typename T, typename Acc = typename T::access, typename KeyFn = rh_key >
+struct radix_heap
+{
+        static constexpr bool noexcept_access =
+            _nothrow_access< Acc, T > && std::is_nothrow_invocable_v< KeyFn&, T const& >;
+
+        static constexpr std::size_t bucket_count = 65;
+
+        radix_heap() noexcept                      = default;
+        radix_heap( radix_heap const& )            = delete;
+        radix_heap& operator=( radix_heap const& ) = delete;
+
+        /// Constructs a heap with the given key extractor.
+        radix_heap( KeyFn key_fn )
+          : _key_fn( std::move( key_fn ) )
+        {
+        }
+
+        /// Move constructor, moved-from heap becomes empty.
+        radix_heap( radix_heap&& other ) noexcept( _nothrow_access< Acc, T > ) = default;
+
+        /// Move assignment operator, moved-from heap becomes empty. Nodes of the current heap are
+        /// unlinked from it.
+        radix_heap& operator=( radix_heap&& other ) noexcept( _nothrow_access< Acc, T > ) = default;
+
+        /// Links the node `node` into the heap, node is detached from any other list it might be
+        /// attached to. Undefined behavior if key of `node` is smaller than `last_key()`.
+        void link( T& node ) noexcept( noexcept_access )
+        {
+                std::uint64_t k = _key_fn( std::as_const( node ) );
+                ZLL_ASSERT( k >= _last );
+                std::size_t i = _bucket_of( k );
+                _buckets[i].link_back( node );
+                if ( i != 0 )
+                        _mask |= std::uint64_t{ 1 } << ( i - 1 );
+        }
+
+        /// Returns true if the heap is empty, i.e. contains no nodes.
+        bool empty() const noexcept
+        {
+                if ( !_buckets[0].empty() )
+                        return false;
+                for ( std::uint64_t m = _mask; m; m &= m - 1 ) {
+                        auto i = static_cast< std::size_t >( std::countr_zero( m ) ) + 1;
+                        if ( !_buckets[i].empty() )
+                                return false;
+                }
+                return true;
+        }
+
+        /// Returns pointer to the node with the smallest key or nullptr if the heap is empty. The
+        /// returned node becomes the new reference point of the heap, see `last_key`.
+        T* top() noexcept( noexcept_access )
+        {
+                if ( _buckets[0].empty() )
+                        _refill();
+                return _buckets[0].first;
+        }
+
+        /// Unlinks the node with the smallest key from the heap. Undefined behavior if the heap is
+        /// empty.
+        void pop() noexcept( noexcept_access )
+        {
+                take();
+        }
+
+        /// Unlinks and returns the node with the smallest key from the heap. Undefined behavior if
+        /// the heap is empty.
+        T& take() noexcept( noexcept_access )
+        {
+                T* n = top();
+                ZLL_ASSERT( n );
+                return _buckets[0].take_front();
+        }
+
+        /// Returns the key of the last node returned by `top`, new nodes must not have smaller key.
+        std::uint64_t last_key() const noexcept
+        {
+                return _last;
+        }
+
+private:
+        std::size_t _bucket_of( std::uint64_t k ) const noexcept
+        {
+                return static_cast< std::size_t >( std::bit_width( k ^ _last ) );
+        }
+
+        void _refill() noexcept( noexcept_access )
+        {
+                std::size_t i = 0;
+                while ( _mask ) {
+                        i = static_cast< std::size_t >( std::countr_zero( _mask ) ) + 1;
+                        if ( !_buckets[i].empty() )
+                                break;
+                        _mask &= _mask - 1;
+                        i = 0;
+                }
+                if ( i == 0 )
+                        return;
+                _mask &= _mask - 1;
+
+                auto&         b = _buckets[i];
+                std::uint64_t k = _key_fn( std::as_const( *b.first ) );
+                for ( T const& n : std::as_const( b ) )
+                        if ( std::uint64_t nk = _key_fn( n ); nk < k )
+                                k = nk;
+                _last = k;
+
+                // All nodes of the bucket share bits above `i - 1` with the new `_last`, they are
+                // redistributed into buckets below `i`.
+                while ( !b.empty() ) {
+                        T&          n = b.take_front();
+                        std::size_t j = _bucket_of( _key_fn( std::as_const( n ) ) );
+                        ZLL_ASSERT( j < i );
+                        _buckets[j].link_back( n );
+                        if ( j != 0 )
+                                _mask |= std::uint64_t{ 1 } << ( j - 1 );
+                }
+        }
+
+        ll_list< T, Acc >           _buckets[bucket_count];
+        std::uint64_t               _last = 0;
+        std::uint64_t               _mask = 0;
+        [[no_unique_address]] KeyFn _key_fn{};
+};
+
 }  // namespace zll
@@ -0,0 +1,430 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#pragma once
+
+#include "zll.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+namespace zll
+{
+
+/// Node of a wait queue, embedded in awaiters that live in the coroutine frame. If the suspended
+/// coroutine is destroyed, the awaiter is destroyed with it and unlinks itself from the queue.
+struct co_waiter : ll_base< co_waiter >
+{
+        std::coroutine_handle<> handle;
+};
+
+/// Resumes all waiters of the list in order. The list is detached from its source first, so
+/// waiters linked or destroyed by resumed coroutines do not affect the batch.
+inline void _co_resume_all( ll_list< co_waiter >&& waiters ) noexcept
+{
+        ll_list< co_waiter > batch = std::move( waiters );
+        while ( !batch.empty() )
+                batch.take_front().handle.resume();
+}
+
+/// Awaiter that suspends on `Sync` unless `Sync::_try_acquire` succeeds, `Sync` links it into its
+/// wait queue and hands the resource over to it on wake-up.
+template < typename Sync >
+struct _co_acquire_awaiter : co_waiter
+{
+        Sync& sync;
+
+        _co_acquire_awaiter( Sync& s ) noexcept
+          : sync( s )
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+                return sync._try_acquire();
+        }
+
+        void await_suspend( std::coroutine_handle<> h ) noexcept
+        {
+                handle = h;
+                sync._waiters.link_back( *this );
+        }
+
+        void await_resume() noexcept
+        {
+        }
+};
+
+/// Manual-reset event, coroutines awaiting it are suspended until `set` is called. All of them are
+/// resumed as one batch by `set`, on the thread calling it. Not thread-safe, intended for a single
+/// threaded executor.
+struct async_event
+{
+        struct awaiter : co_waiter
+        {
+                async_event& ev;
+
+                awaiter( async_event& e ) noexcept
+                  : ev( e )
+                {
+                }
+
+                bool await_ready() noexcept
+                {
+                        return ev._set;
+                }
+
+                void await_suspend( std::coroutine_handle<> h ) noexcept
+                {
+                        handle = h;
+                        ev._waiters.link_back( *this );
+                }
+
+                void await_resume() noexcept
+                {
+                }
+        };
+
+        async_event( bool set = false ) noexcept
+          : _set( set )
+        {
+        }
+
+        async_event( async_event const& )            = delete;
+        async_event& operator=( async_event const& ) = delete;
+
+        awaiter operator co_await() noexcept
+        {
+                return awaiter{ *this };
+        }
+
+        /// Sets the event and resumes all waiting coroutines.
+        void set() noexcept
+        {
+                _set = true;
+                _co_resume_all( std::move( _waiters ) );
+        }
+
+        /// Resets the event, following awaits suspend again.
+        void reset() noexcept
+        {
+                _set = false;
+        }
+
+        bool is_set() const noexcept
+        {
+                return _set;
+        }
+
+private:
+        bool                 _set = false;
+        ll_list< co_waiter > _waiters;
+};
+
+/// Mutex for coroutines, waiters are queued in FIFO order and `unlock` hands the ownership directly
+/// to the first waiter and resumes it. Not thread-safe, intended for a single threaded executor.
+struct async_mutex
+{
+        /// Unlocks the mutex on destruction.
+        struct guard
+        {
+                guard( async_mutex& m ) noexcept
+                  : _m( &m )
+                {
+                }
+
+                guard( guard&& o ) noexcept
+                  : _m( std::exchange( o._m, nullptr ) )
+                {
+                }
+
+                guard( guard const& )            = delete;
+                guard& operator=( guard const& ) = delete;
+                guard& operator=( guard&& )      = delete;
+
+                ~guard()
+                {
+                        if ( _m )
+                                _m->unlock();
+                }
+
+        private:
+                async_mutex* _m;
+        };
+
+        struct scoped_awaiter : _co_acquire_awaiter< async_mutex >
+        {
+                using _co_acquire_awaiter::_co_acquire_awaiter;
+
+                guard await_resume() noexcept
+                {
+                        return guard{ sync };
+                }
+        };
+
+        async_mutex() noexcept = default;
+
+        async_mutex( async_mutex const& )            = delete;
+        async_mutex& operator=( async_mutex const& ) = delete;
+
+        /// Awaitable that locks the mutex.
+        _co_acquire_awaiter< async_mutex > lock() noexcept
+        {
+                return { *this };
+        }
+
+        /// Awaitable that locks the mutex and returns `guard` unlocking it.
+        scoped_awaiter scoped_lock() noexcept
+        {
+                return { *this };
+        }
+
+        bool try_lock() noexcept
+        {
+                return _try_acquire();
+        }
+
+        /// Unlocks the mutex, if there is a waiter it becomes the owner and is resumed.
+        void unlock() noexcept
+        {
+                ZLL_ASSERT( _locked );
+                if ( _waiters.empty() )
+                        _locked = false;
+                else
+                        _waiters.take_front().handle.resume();
+        }
+
+        bool is_locked() const noexcept
+        {
+                return _locked;
+        }
+
+private:
+        friend _co_acquire_awaiter< async_mutex >;
+
+        bool _try_acquire() noexcept
+        {
+                if ( _locked )
+                        return false;
+                _locked = true;
+                return true;
+        }
+
+        bool                 _locked = false;
+        ll_list< co_waiter > _waiters;
+};
+
+/// Counting semaphore for coroutines, waiters are queued in FIFO order. `release( n )` hands units
+/// directly to up to `n` waiters and resumes them as one batch. Not thread-safe, intended for a
+/// single threaded executor.
+struct async_semaphore
+{
+        async_semaphore( std::size_t count = 0 ) noexcept
+          : _count( count )
+        {
+        }
+
+        async_semaphore( async_semaphore const& )            = delete;
+        async_semaphore& operator=( async_semaphore const& ) = delete;
+
+        /// Awaitable that acquires one unit.
+        _co_acquire_awaiter< async_semaphore > acquire() noexcept
+        {
+                return { *this };
+        }
+
+        bool try_acquire() noexcept
+        {
+                return _try_acquire();
+        }
+
+        /// Releases `n` units, waiters take them first and are resumed after all of them were
+        /// assigned a unit.
+        void release( std::size_t n = 1 ) noexcept
+        {
+                ll_list< co_waiter > batch;
+                for ( ; n > 0 && !_waiters.empty(); --n )
+                        batch.link_back( _waiters.take_front() );
+                _count += n;
+                _co_resume_all( std::move( batch ) );
+        }
+
+        std::size_t count() const noexcept
+        {
+                return _count;
+        }
+
+private:
+        friend _co_acquire_awaiter< async_semaphore >;
+
+        bool _try_acquire() noexcept
+        {
+                if ( _count == 0 || !_waiters.empty() )
+                        return false;
+                --_count;
+                return true;
+        }
+
+        std::size_t          _count = 0;
+        ll_list< co_waiter > _waiters;
+};
+
+/// Single threaded executor of coroutines. Ready coroutines are kept in `ll_list` and sleeping ones
+/// in `sh_heap` keyed by deadline, nodes of both are awaiters living in coroutine frames, hence
+/// scheduling does not allocate and destroying a suspended coroutine unschedules it.
+template < typename Clock = std::chrono::steady_clock >
+struct basic_run_loop
+{
+        using clock      = Clock;
+        using time_point = typename Clock::time_point;
+        using duration   = typename Clock::duration;
+
+        /// Awaiter suspending the coroutine until the deadline, does not suspend if the deadline
+        /// already passed.
+        struct sleeper : co_waiter, sh_base< sleeper >
+        {
+                basic_run_loop& loop;
+                time_point      deadline;
+
+                sleeper( basic_run_loop& l, time_point t ) noexcept
+                  : loop( l )
+                  , deadline( t )
+                {
+                }
+
+                bool operator<( sleeper const& o ) const noexcept
+                {
+                        return deadline < o.deadline;
+                }
+
+                bool await_ready() noexcept
+                {
+                        return deadline <= Clock::now();
+                }
+
+                void await_suspend( std::coroutine_handle<> h ) noexcept
+                {
+                        handle = h;
+                        loop._timers.link( *this );
+                }
+
+                void await_resume() noexcept
+                {
+                }
+        };
+
+        /// Awaiter moving the coroutine to the end of the ready queue.
+        struct yielder : co_waiter
+        {
+                basic_run_loop& loop;
+
+                yielder( basic_run_loop& l ) noexcept
+                  : loop( l )
+                {
+                }
+
+                bool await_ready() noexcept
+                {
+                        return false;
+                }
+
+                void await_suspend( std::coroutine_handle<> h ) noexcept
+                {
+                        handle = h;
+                        loop._ready.link_back( *this );
+                }
+
+                void await_resume() noexcept
+                {
+                }
+        };
+
+        basic_run_loop() noexcept = default;
+
+        basic_run_loop( basic_run_loop const& )            = delete;
+        basic_run_loop& operator=( basic_run_loop const& ) = delete;
+
+        /// Awaitable that resumes the coroutine on the loop once `t` passes.
+        sleeper sleep_until( time_point t ) noexcept
+        {
+                return { *this, t };
+        }
+
+        /// Awaitable that resumes the coroutine on the loop after `d`.
+        sleeper sleep_for( duration d ) noexcept
+        {
+                return { *this, Clock::now() + d };
+        }
+
+        /// Awaitable that reschedules the coroutine on the loop, used also to move coroutine
+        /// started elsewhere into the loop.
+        yielder yield() noexcept
+        {
+                return { *this };
+        }
+
+        /// Returns true if there are no ready or sleeping coroutines.
+        bool empty() const noexcept
+        {
+                return _ready.empty() && _timers.empty();
+        }
+
+        /// One tick of the loop: all expired sleepers are moved to the ready queue at once in order
+        /// of their deadlines, then coroutines ready at the start of the tick are resumed as one
+        /// batch. Coroutines scheduled during the batch run in the next tick. Returns the number of
+        /// resumed coroutines.
+        std::size_t poll() noexcept
+        {
+                // popping keeps the deadline order without sort, O(k log n) for k expired sleepers
+                auto now = Clock::now();
+                while ( !_timers.empty() && !( now < _timers.top->deadline ) )
+                        _ready.link_back( _timers.take() );
+
+                ll_list< co_waiter > batch = std::move( _ready );
+                std::size_t          n     = 0;
+                for ( ; !batch.empty(); ++n )
+                        batch.take_front().handle.resume();
+                return n;
+        }
+
+        /// Runs the loop until there are no ready or sleeping coroutines. When nothing is ready,
+        /// the thread sleeps until the nearest deadline.
+        void run()
+        {
+                while ( !empty() ) {
+                        poll();
+                        if ( _ready.empty() && !_timers.empty() )
+                                std::this_thread::sleep_until( _timers.top->deadline );
+                }
+        }
+
+private:
+        ll_list< co_waiter >                                    _ready;
+        sh_heap< sleeper, typename sh_base< sleeper >::access > _timers;
+};
+
+using run_loop = basic_run_loop<>;
+
+}  // namespace zll
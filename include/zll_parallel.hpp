@@ -0,0 +1,524 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#pragma once
+
+#include "zll.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zll
+{
+
+/// Runs `f( i )` for each `i` in [0, n), each call on its own thread except the last one, which
+/// runs on the calling thread. If a thread can't be spawned, its work is done on the calling
+/// thread instead.
+template < typename F >
+void _par_run( std::size_t n, F& f )
+{
+        std::vector< std::thread > ts;
+        for ( std::size_t i = 0; i + 1 < n; i++ ) {
+                try {
+                        ts.emplace_back( [&f, i] {
+                                f( i );
+                        } );
+                }
+                catch ( ... ) {
+                        f( i );
+                }
+        }
+        if ( n > 0 )
+                f( n - 1 );
+        for ( auto& t : ts )
+                t.join();
+}
+
+/// Returns the number of threads to use for `n` nodes, so that no thread gets less than
+/// `min_chunk` nodes.
+inline std::size_t
+_par_threads( std::size_t threads, std::size_t n, std::size_t min_chunk ) noexcept
+{
+        std::size_t k = n / min_chunk;
+        if ( threads == 0 )
+                threads = 1;
+        return k < threads ? ( k == 0 ? 1 : k ) : threads;
+}
+
+/// Walks the list once and returns pointers to evenly spaced nodes of the list, first of them is
+/// the front. Between `k` and `2 * k` nodes are returned for lists with at least `k` nodes: every
+/// `stride`-th node is recorded and once `2 * k` nodes are recorded, every other is dropped and
+/// `stride` doubles. Number of nodes in the list is stored into `n`.
+template < typename T, typename Acc >
+std::vector< T* > _ll_split_points( ll_list< T, Acc >& l, std::size_t k, std::size_t& n )
+{
+        std::vector< T* > marks;
+        marks.reserve( 2 * k );
+        std::size_t stride = 1;
+        n                  = 0;
+        for ( T& x : l ) {
+                if ( n % stride == 0 ) {
+                        if ( marks.size() == 2 * k ) {
+                                for ( std::size_t i = 0; i < k; i++ )
+                                        marks[i] = marks[2 * i];
+                                marks.resize( k );
+                                stride *= 2;
+                        }
+                        if ( n % stride == 0 )
+                                marks.push_back( &x );
+                }
+                ++n;
+        }
+        return marks;
+}
+
+/// Sorts the list using up to `threads` threads. Split points are recorded in one pass, see
+/// `_ll_split_points`, and the list is cut into sublists there without walking it again,
+/// each sublist is sorted on its own thread and the sorted sublists are merged in parallel rounds
+/// of pairwise `merge`. The sort is stable. Short lists are sorted on the calling thread.
+///
+/// `cmp` is invoked concurrently from multiple threads and should not throw.
+template < typename T, typename Acc, typename Compare = std::less<> >
+void parallel_sort(
+    ll_list< T, Acc >& l,
+    Compare            cmp     = std::less<>{},
+    std::size_t        threads = std::thread::hardware_concurrency() )
+{
+        constexpr std::size_t min_chunk = 4096;
+
+        if ( l.empty() )
+                return;
+        if ( threads == 0 )
+                threads = 1;
+
+        std::size_t n     = 0;
+        auto        marks = _ll_split_points( l, threads, n );
+        std::size_t m     = marks.size();
+        std::size_t k     = std::min( _par_threads( threads, n, min_chunk ), m );
+        if ( k == 1 ) {
+                _ll_merge_sort( l, cmp );
+                return;
+        }
+
+        // parts are cut from the back, so the node before each split point is still linked
+        std::vector< ll_list< T, Acc > > parts( k );
+        for ( std::size_t i = k; i-- > 0; ) {
+                T& first = *marks[i * m / k];
+                T& last  = l.back();
+                detach_range< T, Acc >( first, last );
+                parts[i].link_range_back( first, last );
+        }
+
+        auto sort_part = [&]( std::size_t i ) {
+                _ll_merge_sort( parts[i], cmp );
+        };
+        _par_run( k, sort_part );
+
+        for ( std::size_t step = 1; step < k; step *= 2 ) {
+                auto merge_pair = [&]( std::size_t i ) {
+                        std::size_t lh = i * 2 * step;
+                        parts[lh].merge( std::move( parts[lh + step] ), cmp );
+                };
+                _par_run( ( k - step + 2 * step - 1 ) / ( 2 * step ), merge_pair );
+        }
+
+        l = std::move( parts[0] );
+}
+
+/// Calls `f` on each node of the list, the list is split into up to `chunks` consecutive parts
+/// that are processed concurrently. Split points are recorded in one walk over the list and no
+/// node is detached. Each part is passed to executor `ex` as a task: `ex( k, task )` has to call
+/// `task( i )` exactly once for each `i` in [0, k) and return once all of the calls finished.
+///
+/// `f` is invoked concurrently from multiple threads, must not throw and must not modify the
+/// structure of the list.
+template < typename T, typename Acc, typename F, typename Executor >
+void parallel_for_each( ll_list< T, Acc >& l, F&& f, std::size_t chunks, Executor&& ex )
+{
+        constexpr std::size_t min_chunk = 256;
+
+        if ( l.empty() )
+                return;
+        if ( chunks == 0 )
+                chunks = 1;
+
+        std::size_t n     = 0;
+        auto        marks = _ll_split_points( l, chunks, n );
+        std::size_t m     = marks.size();
+        std::size_t k     = std::min( _par_threads( chunks, n, min_chunk ), m );
+
+        auto task = [&]( std::size_t i ) {
+                T* e = i + 1 < k ? marks[( i + 1 ) * m / k] : nullptr;
+                for ( T* x = marks[i * m / k]; x != e; ) {
+                        T* next = _node( Acc::get( *x ).next );
+                        f( *x );
+                        x = next;
+                }
+        };
+        ex( k, task );
+}
+
+/// Calls `f` on each node of the list using up to `threads` threads, see the executor overload
+/// for details.
+template < typename T, typename Acc, typename F >
+requires( std::invocable< F&, T& > )
+void parallel_for_each(
+    ll_list< T, Acc >& l,
+    F&&                f,
+    std::size_t        threads = std::thread::hardware_concurrency() )
+{
+        parallel_for_each( l, f, threads, []( std::size_t k, auto& task ) {
+                _par_run( k, task );
+        } );
+}
+
+struct _ws_queue;
+struct ws_scheduler;
+
+/// Intrusive task of `ws_scheduler`, `fn( *this )` is called once the task is picked by a worker.
+/// Submitting does not allocate. Destroying a queued task cancels it, but the task must not be
+/// destroyed while it may be running: `cancel` returns false once a worker took the task.
+///
+/// Worker does not touch the task after `fn` was called, so `fn` can destroy or resubmit it.
+struct ws_task : ll_base< ws_task >
+{
+        void ( *fn )( ws_task& ) = nullptr;
+
+        ws_task( void ( *f )( ws_task& ) ) noexcept
+          : fn( f )
+        {
+        }
+
+        ws_task( ws_task const& )            = delete;
+        ws_task& operator=( ws_task const& ) = delete;
+
+        /// Removes the task from its queue, returns false if it is not queued.
+        bool cancel() noexcept;
+
+        ~ws_task()
+        {
+                cancel();
+        }
+
+private:
+        friend ws_scheduler;
+
+        std::atomic< _ws_queue* > _queue = nullptr;
+};
+
+/// Task queue of `ws_scheduler`, the list is guarded by the mutex.
+struct _ws_queue
+{
+        std::mutex                  m;
+        ll_list< ws_task >          tasks;
+        std::atomic< std::size_t >* pending = nullptr;
+};
+
+inline bool ws_task::cancel() noexcept
+{
+        for ( ;; ) {
+                _ws_queue* q = _queue.load( std::memory_order_acquire );
+                if ( !q )
+                        return false;
+                std::lock_guard g{ q->m };
+                if ( _queue.load( std::memory_order_relaxed ) != q )
+                        continue;
+                detach( *this );
+                _queue.store( nullptr, std::memory_order_relaxed );
+                if ( q->pending->fetch_sub( 1 ) == 1 )
+                        q->pending->notify_all();
+                return true;
+        }
+}
+
+/// Worker of scheduler running on the current thread, if any.
+struct _ws_current
+{
+        ws_scheduler* sched = nullptr;
+        std::size_t   index = 0;
+};
+
+inline thread_local _ws_current _ws_this_thread;
+
+/// Work-stealing scheduler of `ws_task` nodes. Each worker has a local queue: tasks submitted from
+/// a worker go to its back and the worker pops from the back (LIFO), while idle workers steal from
+/// the front of others (FIFO). Tasks submitted from other threads go to the global injection
+/// queue. Workers with nothing to do are parked on atomic wait.
+///
+/// Queues are guarded by mutexes, a steal is a single locked `take_front`. Destructor runs all
+/// tasks that are still queued and joins the workers.
+struct ws_scheduler
+{
+        ws_scheduler( std::size_t threads = std::thread::hardware_concurrency() )
+          : _n( threads == 0 ? 1 : threads )
+          , _queues( std::make_unique< _ws_queue[] >( _n + 1 ) )
+        {
+                for ( std::size_t i = 0; i <= _n; i++ )
+                        _queues[i].pending = &_pending;
+                _threads.reserve( _n );
+                for ( std::size_t i = 0; i < _n; i++ )
+                        _threads.emplace_back( [this, i] {
+                                _work( i );
+                        } );
+        }
+
+        ws_scheduler( ws_scheduler const& )            = delete;
+        ws_scheduler& operator=( ws_scheduler const& ) = delete;
+
+        /// Queues the task, it must not be queued already.
+        void submit( ws_task& t ) noexcept
+        {
+                _ws_current& c = _ws_this_thread;
+                _ws_queue&   q = c.sched == this ? _queues[c.index] : _queues[_n];
+                _pending.fetch_add( 1 );
+                {
+                        std::lock_guard g{ q.m };
+                        q.tasks.link_back( t );
+                        t._queue.store( &q, std::memory_order_relaxed );
+                }
+                _epoch.fetch_add( 1 );
+                if ( _sleepers.load() > 0 )
+                        _epoch.notify_one();
+        }
+
+        /// Blocks until all submitted tasks finished or were cancelled.
+        void wait_idle() const noexcept
+        {
+                for ( std::size_t p = _pending.load(); p != 0; p = _pending.load() )
+                        _pending.wait( p );
+        }
+
+        /// Number of worker threads.
+        std::size_t size() const noexcept
+        {
+                return _n;
+        }
+
+        ~ws_scheduler()
+        {
+                _stop.store( true );
+                _epoch.fetch_add( 1 );
+                _epoch.notify_all();
+                for ( auto& t : _threads )
+                        t.join();
+        }
+
+private:
+        /// Takes a task from the back or the front of the queue.
+        static ws_task* _take( _ws_queue& q, bool back ) noexcept
+        {
+                std::lock_guard g{ q.m };
+                if ( q.tasks.empty() )
+                        return nullptr;
+                ws_task& t = back ? q.tasks.take_back() : q.tasks.take_front();
+                t._queue.store( nullptr, std::memory_order_relaxed );
+                return &t;
+        }
+
+        /// Finds work for worker `i`: own queue, injection queue and then queues of others.
+        ws_task* _find( std::size_t i ) noexcept
+        {
+                if ( ws_task* t = _take( _queues[i], true ) )
+                        return t;
+                if ( ws_task* t = _take( _queues[_n], false ) )
+                        return t;
+                for ( std::size_t j = 1; j < _n; j++ )
+                        if ( ws_task* t = _take( _queues[( i + j ) % _n], false ) )
+                                return t;
+                return nullptr;
+        }
+
+        void _run( ws_task& t ) noexcept
+        {
+                t.fn( t );
+                if ( _pending.fetch_sub( 1 ) == 1 )
+                        _pending.notify_all();
+        }
+
+        void _work( std::size_t i ) noexcept
+        {
+                _ws_this_thread = { this, i };
+                for ( ;; ) {
+                        if ( ws_task* t = _find( i ) ) {
+                                _run( *t );
+                                continue;
+                        }
+                        std::uint32_t e = _epoch.load();
+                        if ( ws_task* t = _find( i ) ) {
+                                _run( *t );
+                                continue;
+                        }
+                        if ( _stop.load() )
+                                break;
+                        _sleepers.fetch_add( 1 );
+                        _epoch.wait( e );
+                        _sleepers.fetch_sub( 1 );
+                }
+                _ws_this_thread = {};
+        }
+
+        std::size_t                    _n;
+        std::unique_ptr< _ws_queue[] > _queues;
+        std::vector< std::thread >     _threads;
+        std::atomic< std::size_t >     _pending  = 0;
+        std::atomic< std::uint32_t >   _epoch    = 0;
+        std::atomic< std::size_t >     _sleepers = 0;
+        std::atomic< bool >            _stop     = false;
+};
+
+/// Thread parked in `parking_lot`, lives on the stack of the parked thread.
+struct _park_node : ll_base< _park_node >
+{
+        void const*                  addr  = nullptr;
+        std::atomic< std::uint32_t > woken = 0;
+};
+
+/// Bucket of `parking_lot`: spinlock guarded queue of parked threads.
+struct alignas( 64 ) _park_bucket
+{
+        std::atomic_flag      lock = ATOMIC_FLAG_INIT;
+        ll_list< _park_node > queue;
+
+        void acquire() noexcept
+        {
+                while ( lock.test_and_set( std::memory_order_acquire ) )
+                        while ( lock.test( std::memory_order_relaxed ) )
+                                std::this_thread::yield();
+        }
+
+        void release() noexcept
+        {
+                lock.clear( std::memory_order_release );
+        }
+};
+
+/// Global table of wait queues keyed by address, used to block threads on arbitrary memory
+/// locations in the style of futex. Each bucket of the fixed hash table is a spinlock guarded
+/// `ll_list` of nodes living on stacks of the parked threads, so parking does not allocate and a
+/// synchronization object needs no storage for its waiters: a lock can be a single byte.
+struct parking_lot
+{
+        /// Number of buckets of the table.
+        static constexpr std::size_t buckets = 256;
+
+        /// Parks the calling thread on `addr` if `validate()` returns true, it is called with the
+        /// bucket locked so no `unpark_*` on `addr` can interleave. Returns false if the thread was
+        /// not parked, true once it was woken up by `unpark_one` or `unpark_all`.
+        template < typename Validate >
+        static bool park( void const* addr, Validate&& validate ) noexcept
+        {
+                _park_bucket& b = _bucket( addr );
+                _park_node    n;
+                n.addr = addr;
+                b.acquire();
+                if ( !validate() ) {
+                        b.release();
+                        return false;
+                }
+                b.queue.link_back( n );
+                b.release();
+
+                while ( n.woken.load( std::memory_order_acquire ) == 0 )
+                        n.woken.wait( 0, std::memory_order_acquire );
+                // the waking thread holds the bucket until it is done with the node
+                b.acquire();
+                b.release();
+                return true;
+        }
+
+        /// Wakes the thread parked on `addr` first. `f( have_more )` is called with the bucket
+        /// locked before the wake up, `have_more` tells whether other threads stay parked on
+        /// `addr`. Returns true if a thread was woken up.
+        template < typename F >
+        static bool unpark_one( void const* addr, F&& f ) noexcept
+        {
+                _park_bucket& b = _bucket( addr );
+                b.acquire();
+                _park_node* n = nullptr;
+                for ( _park_node& x : b.queue ) {
+                        if ( x.addr != addr )
+                                continue;
+                        if ( n ) {
+                                f( true );
+                                _wake( *n );
+                                b.release();
+                                return true;
+                        }
+                        n = &x;
+                }
+                f( false );
+                if ( n )
+                        _wake( *n );
+                b.release();
+                return n != nullptr;
+        }
+
+        /// Wakes the thread parked on `addr` first, returns true if there was one.
+        static bool unpark_one( void const* addr ) noexcept
+        {
+                return unpark_one( addr, []( bool ) {} );
+        }
+
+        /// Wakes all threads parked on `addr`, returns their number.
+        static std::size_t unpark_all( void const* addr ) noexcept
+        {
+                _park_bucket& b = _bucket( addr );
+                std::size_t   k = 0;
+                b.acquire();
+                for ( auto it = b.queue.begin(); it != b.queue.end(); ) {
+                        _park_node& x = *it++;
+                        if ( x.addr != addr )
+                                continue;
+                        _wake( x );
+                        ++k;
+                }
+                b.release();
+                return k;
+        }
+
+private:
+        static _park_bucket& _bucket( void const* addr ) noexcept
+        {
+                static _park_bucket table[buckets];
+                auto                h = reinterpret_cast< std::uintptr_t >( addr );
+                h                     = ( h >> 3 ) * 0x9E3779B97F4A7C15ull;
+                return table[( h >> 32 ) % buckets];
+        }
+
+        /// Unlinks the node and wakes its thread, the bucket has to be locked.
+        static void _wake( _park_node& n ) noexcept
+        {
+                detach( n );
+                n.woken.store( 1, std::memory_order_release );
+                n.woken.notify_one();
+        }
+};
+
+}  // namespace zll
@@ -0,0 +1,277 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#pragma once
+
+#include "zll.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <sys/epoll.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace zll
+{
+
+struct reactor;
+
+/// Handler of file descriptor registered in `reactor`. Handler is a node of the ready list of the
+/// reactor and of its heap of timeouts, so dispatching events needs no allocation and no lookup
+/// table: epoll reports the handler itself. Destroying the handler removes its registration, its
+/// timeout and its pending events at once.
+///
+/// Callback `cb( handler, events )` gets the epoll events that became ready, or zero if the timeout
+/// expired first. The reactor does not touch the handler after calling `cb`, so it can destroy
+/// itself.
+struct fd_handler : ll_base< fd_handler >, sh_base< fd_handler >
+{
+        using clock      = std::chrono::steady_clock;
+        using ll_access  = ll_base< fd_handler >::access;
+        using sh_access  = sh_base< fd_handler >::access;
+        using callback_t = void ( * )( fd_handler&, std::uint32_t );
+
+        callback_t cb;
+
+        fd_handler( callback_t c ) noexcept
+          : cb( c )
+        {
+        }
+
+        fd_handler( fd_handler const& )            = delete;
+        fd_handler& operator=( fd_handler const& ) = delete;
+
+        /// Registered file descriptor, -1 if the handler is not registered.
+        int fd() const noexcept
+        {
+                return _fd;
+        }
+
+        /// Deadline of the timeout, valid only while it is armed.
+        clock::time_point deadline() const noexcept
+        {
+                return _deadline;
+        }
+
+        bool operator<( fd_handler const& o ) const noexcept
+        {
+                return _deadline < o._deadline;
+        }
+
+        ~fd_handler();
+
+private:
+        friend reactor;
+
+        reactor*          _reactor = nullptr;
+        int               _fd      = -1;
+        std::uint32_t     _events  = 0;
+        clock::time_point _deadline{};
+};
+
+/// Single threaded epoll reactor dispatching `fd_handler` nodes. Each `run_once` waits until an
+/// event or the nearest timeout from the top of the `sh_heap` of timeouts, links ready handlers to
+/// the ready list together with all expired timeouts and dispatches them as one batch.
+///
+/// Handlers must be removed or destroyed before the reactor.
+struct reactor
+{
+        using clock = fd_handler::clock;
+
+        /// Number of events fetched by one `epoll_wait`.
+        static constexpr int max_events = 64;
+
+        reactor() noexcept
+          : _ep( ::epoll_create1( EPOLL_CLOEXEC ) )
+          , _err( _ep < 0 ? errno : 0 )
+        {
+        }
+
+        reactor( reactor const& )            = delete;
+        reactor& operator=( reactor const& ) = delete;
+
+        /// Returns the error of `epoll_create1`, if any.
+        std::error_code error() const noexcept
+        {
+                return { _err, std::system_category() };
+        }
+
+        /// Registers handler for `events` on `fd`, the handler must not be registered already.
+        std::error_code add( fd_handler& h, int fd, std::uint32_t events ) noexcept
+        {
+                ZLL_ASSERT( !h._reactor );
+                epoll_event ev{};
+                ev.events   = events;
+                ev.data.ptr = &h;
+                if ( ::epoll_ctl( _ep, EPOLL_CTL_ADD, fd, &ev ) != 0 )
+                        return { errno, std::system_category() };
+                h._reactor = this;
+                h._fd      = fd;
+                ++_handlers;
+                return {};
+        }
+
+        /// Changes the events the registered handler waits for.
+        std::error_code modify( fd_handler& h, std::uint32_t events ) noexcept
+        {
+                ZLL_ASSERT( h._reactor == this );
+                epoll_event ev{};
+                ev.events   = events;
+                ev.data.ptr = &h;
+                if ( ::epoll_ctl( _ep, EPOLL_CTL_MOD, h._fd, &ev ) != 0 )
+                        return { errno, std::system_category() };
+                return {};
+        }
+
+        /// Unregisters the handler, cancels its timeout and drops its pending events. The file
+        /// descriptor is not closed. It may be closed already, unless it was duplicated: epoll
+        /// keeps the registration while any duplicate is open.
+        void remove( fd_handler& h ) noexcept
+        {
+                if ( h._reactor != this )
+                        return;
+                ::epoll_ctl( _ep, EPOLL_CTL_DEL, h._fd, nullptr );
+                cancel_timeout( h );
+                detach< fd_handler, fd_handler::ll_access >( h );
+                h._reactor = nullptr;
+                h._fd      = -1;
+                h._events  = 0;
+                --_handlers;
+        }
+
+        /// Arms the timeout of the handler to `t`, replacing the previous one.
+        void set_timeout( fd_handler& h, clock::time_point t ) noexcept
+        {
+                cancel_timeout( h );
+                h._deadline = t;
+                _timers.link( h );
+        }
+
+        /// Arms the timeout of the handler to `d` from now.
+        void set_timeout( fd_handler& h, clock::duration d ) noexcept
+        {
+                set_timeout( h, clock::now() + d );
+        }
+
+        /// Disarms the timeout of the handler, if armed.
+        void cancel_timeout( fd_handler& h ) noexcept
+        {
+                if ( !detached< fd_handler, fd_handler::sh_access >( h ) )
+                        detach< fd_handler, fd_handler::sh_access >( h, std::less<>{} );
+        }
+
+        /// Number of registered handlers.
+        std::size_t size() const noexcept
+        {
+                return _handlers;
+        }
+
+        /// Waits for events for at most `max_wait` milliseconds, or until the nearest timeout,
+        /// negative value waits without limit. Expired timeouts are disarmed. Returns the number of
+        /// dispatched handlers.
+        std::size_t run_once( int max_wait = -1 ) noexcept
+        {
+                int timeout = max_wait;
+                if ( !_timers.empty() ) {
+                        auto d = std::chrono::ceil< std::chrono::milliseconds >(
+                            _timers.top->_deadline - clock::now() );
+                        // far deadlines do not fit `int`, saturate instead of wrapping
+                        int ms = static_cast< int >( std::clamp< decltype( d.count() ) >(
+                            d.count(), 0, std::numeric_limits< int >::max() ) );
+                        if ( timeout < 0 || ms < timeout )
+                                timeout = ms;
+                }
+
+                epoll_event evs[max_events];
+                int         n = ::epoll_wait( _ep, evs, max_events, timeout );
+                ZLL_ASSERT( n >= 0 || errno == EINTR );
+                for ( int i = 0; i < n; i++ ) {
+                        auto& h = *static_cast< fd_handler* >( evs[i].data.ptr );
+                        h._events |= evs[i].events;
+                        if ( detached< fd_handler, fd_handler::ll_access >( h ) )
+                                _ready.link_back( h );
+                }
+
+                auto now = clock::now();
+                _timers.take_while(
+                    [&]( fd_handler& h ) {
+                            return !( now < h._deadline );
+                    },
+                    [&]( fd_handler& h ) {
+                            if ( detached< fd_handler, fd_handler::ll_access >( h ) )
+                                    _ready.link_back( h );
+                    } );
+
+                ll_list< fd_handler, fd_handler::ll_access > batch = std::move( _ready );
+                std::size_t                                  k     = 0;
+                for ( ; !batch.empty(); ++k ) {
+                        fd_handler&   h  = batch.take_front();
+                        std::uint32_t ev = std::exchange( h._events, 0 );
+                        h.cb( h, ev );
+                }
+                return k;
+        }
+
+        /// Dispatches events until `stop` is called or no handler is registered and no timeout is
+        /// armed.
+        void run() noexcept
+        {
+                _stop = false;
+                while ( !_stop && ( _handlers > 0 || !_timers.empty() ) )
+                        run_once();
+        }
+
+        /// Makes `run` return after the current batch.
+        void stop() noexcept
+        {
+                _stop = true;
+        }
+
+        ~reactor()
+        {
+                ZLL_ASSERT( _handlers == 0 );
+                if ( _ep >= 0 )
+                        ::close( _ep );
+        }
+
+private:
+        int                                          _ep;
+        int                                          _err;
+        std::size_t                                  _handlers = 0;
+        bool                                         _stop     = false;
+        ll_list< fd_handler, fd_handler::ll_access > _ready;
+        sh_heap< fd_handler, fd_handler::sh_access > _timers;
+};
+
+inline fd_handler::~fd_handler()
+{
+        if ( _reactor )
+                _reactor->remove( *this );
+}
+
+}  // namespace zll
@@ -15,11 +15,17 @@ def _vptr_decode(vptr_val):
     address is the raw pointer value (int), meaningful when kind != 'null'.
     """
     ptr = int(vptr_val["ptr"])
-    if ptr == 0:
+    # bit 0 is the tag, next `Bits` bits are spare flags
+    try:
+        bits = int(vptr_val.type.strip_typedefs().template_argument(2))
+    except (RuntimeError, ValueError):
+        bits = 0
+    addr = ptr & ~((1 << (bits + 1)) - 1)
+    if addr == 0:
         return ("null", 0)
     if ptr & 1:
-        return ("sentinel", ptr & ~1)
-    return ("node", ptr)
+        return ("sentinel", addr)
+    return ("node", addr)
 
 
 # ---------------------------------------------------------------------------
@@ -0,0 +1,348 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "zll_coro.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <doctest/doctest.h>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+
+/// Eagerly started coroutine, the frame is destroyed with the task.
+struct task
+{
+        struct promise_type
+        {
+                task get_return_object() noexcept
+                {
+                        return task{ std::coroutine_handle< promise_type >::from_promise( *this ) };
+                }
+
+                std::suspend_never initial_suspend() noexcept
+                {
+                        return {};
+                }
+
+                std::suspend_always final_suspend() noexcept
+                {
+                        return {};
+                }
+
+                void return_void() noexcept
+                {
+                }
+
+                void unhandled_exception() noexcept
+                {
+                }
+        };
+
+        task( std::coroutine_handle< promise_type > h ) noexcept
+          : _h( h )
+        {
+        }
+
+        task( task&& o ) noexcept
+          : _h( std::exchange( o._h, nullptr ) )
+        {
+        }
+
+        task( task const& )            = delete;
+        task& operator=( task const& ) = delete;
+        task& operator=( task&& )      = delete;
+
+        ~task()
+        {
+                if ( _h )
+                        _h.destroy();
+        }
+
+        bool done() const noexcept
+        {
+                return _h.done();
+        }
+
+private:
+        std::coroutine_handle< promise_type > _h;
+};
+
+task wait_event( async_event& ev, std::vector< int >& log, int id )
+{
+        co_await ev;
+        log.push_back( id );
+}
+
+task with_mutex( async_mutex& m, async_event& ev, std::vector< int >& log, int id )
+{
+        auto g = co_await m.scoped_lock();
+        log.push_back( id );
+        co_await ev;
+        log.push_back( -id );
+}
+
+task with_semaphore( async_semaphore& s, std::vector< int >& log, int id )
+{
+        co_await s.acquire();
+        log.push_back( id );
+}
+
+/// Manually advanced clock for deterministic timer tests.
+struct fake_clock
+{
+        using duration                  = std::chrono::milliseconds;
+        using rep                       = duration::rep;
+        using period                    = duration::period;
+        using time_point                = std::chrono::time_point< fake_clock >;
+        static constexpr bool is_steady = true;
+
+        static inline time_point current{};
+
+        static time_point now() noexcept
+        {
+                return current;
+        }
+};
+
+using fake_loop = basic_run_loop< fake_clock >;
+
+task yielding( fake_loop& l, std::vector< int >& log, int id, int n )
+{
+        co_await l.yield();
+        for ( int i = 0; i < n; ++i ) {
+                log.push_back( id );
+                co_await l.yield();
+        }
+}
+
+task sleeping( fake_loop& l, std::vector< int >& log, int id, int ms )
+{
+        co_await l.sleep_for( std::chrono::milliseconds{ ms } );
+        log.push_back( id );
+}
+
+task sleeping_steady( run_loop& l, std::vector< int >& log, int id, int ms )
+{
+        co_await l.yield();
+        co_await l.sleep_for( std::chrono::milliseconds{ ms } );
+        log.push_back( id );
+}
+
+}  // namespace
+
+TEST_CASE( "async_event" )
+{
+        async_event        ev;
+        std::vector< int > log;
+
+        task t1 = wait_event( ev, log, 1 );
+        task t2 = wait_event( ev, log, 2 );
+        CHECK_FALSE( t1.done() );
+        CHECK( log.empty() );
+
+        SUBCASE( "set resumes all waiters in order" )
+        {
+                ev.set();
+                CHECK_EQ( log, std::vector< int >{ 1, 2 } );
+                CHECK( t1.done() );
+                CHECK( t2.done() );
+
+                task t3 = wait_event( ev, log, 3 );
+                CHECK( t3.done() );
+                CHECK_EQ( log, std::vector< int >{ 1, 2, 3 } );
+        }
+
+        SUBCASE( "destroyed waiter unlinks itself" )
+        {
+                {
+                        task t3 = wait_event( ev, log, 3 );
+                }
+                ev.set();
+                CHECK_EQ( log, std::vector< int >{ 1, 2 } );
+        }
+
+        SUBCASE( "reset" )
+        {
+                ev.set();
+                ev.reset();
+                task t3 = wait_event( ev, log, 3 );
+                CHECK_FALSE( t3.done() );
+                ev.set();
+                CHECK( t3.done() );
+        }
+}
+
+TEST_CASE( "async_mutex" )
+{
+        async_mutex        m;
+        async_event        ev;
+        std::vector< int > log;
+
+        task t1 = with_mutex( m, ev, log, 1 );
+        task t2 = with_mutex( m, ev, log, 2 );
+        CHECK( m.is_locked() );
+        CHECK_FALSE( m.try_lock() );
+        CHECK_EQ( log, std::vector< int >{ 1 } );
+
+        SUBCASE( "ownership is handed over in order" )
+        {
+                task t3 = with_mutex( m, ev, log, 3 );
+                ev.set();
+                CHECK_EQ( log, std::vector< int >{ 1, -1, 2, -2, 3, -3 } );
+                CHECK_FALSE( m.is_locked() );
+        }
+
+        SUBCASE( "destroyed waiter does not get the lock" )
+        {
+                {
+                        task t3 = with_mutex( m, ev, log, 3 );
+                }
+                ev.set();
+                CHECK_EQ( log, std::vector< int >{ 1, -1, 2, -2 } );
+                CHECK_FALSE( m.is_locked() );
+                CHECK( m.try_lock() );
+                m.unlock();
+        }
+}
+
+TEST_CASE( "async_semaphore" )
+{
+        async_semaphore    s{ 1 };
+        std::vector< int > log;
+
+        task t1 = with_semaphore( s, log, 1 );
+        task t2 = with_semaphore( s, log, 2 );
+        task t3 = with_semaphore( s, log, 3 );
+        task t4 = with_semaphore( s, log, 4 );
+        CHECK_EQ( log, std::vector< int >{ 1 } );
+        CHECK_EQ( s.count(), 0 );
+
+        {
+                task t5 = with_semaphore( s, log, 5 );
+        }
+
+        s.release( 2 );
+        CHECK_EQ( log, std::vector< int >{ 1, 2, 3 } );
+        CHECK_EQ( s.count(), 0 );
+
+        s.release( 3 );
+        CHECK_EQ( log, std::vector< int >{ 1, 2, 3, 4 } );
+        CHECK_EQ( s.count(), 2 );
+        CHECK( s.try_acquire() );
+        CHECK_EQ( s.count(), 1 );
+}
+
+TEST_CASE( "run_loop_yield" )
+{
+        fake_loop          l;
+        std::vector< int > log;
+
+        task t1 = yielding( l, log, 1, 2 );
+        task t2 = yielding( l, log, 2, 2 );
+        CHECK( log.empty() );
+        CHECK_FALSE( l.empty() );
+
+        CHECK_EQ( l.poll(), 2 );
+        CHECK_EQ( log, std::vector< int >{ 1, 2 } );
+        CHECK_EQ( l.poll(), 2 );
+        CHECK_EQ( log, std::vector< int >{ 1, 2, 1, 2 } );
+        CHECK_EQ( l.poll(), 2 );
+        CHECK( t1.done() );
+        CHECK( t2.done() );
+        CHECK( l.empty() );
+        CHECK_EQ( l.poll(), 0 );
+}
+
+TEST_CASE( "run_loop_sleep" )
+{
+        fake_clock::current = {};
+        fake_loop          l;
+        std::vector< int > log;
+
+        task t1 = sleeping( l, log, 1, 30 );
+        task t2 = sleeping( l, log, 2, 10 );
+        task t3 = sleeping( l, log, 3, 20 );
+        task t4 = sleeping( l, log, 4, 10 );
+        task t5 = sleeping( l, log, 5, 0 );
+        CHECK_EQ( log, std::vector< int >{ 5 } );
+
+        CHECK_EQ( l.poll(), 0 );
+        fake_clock::current += std::chrono::milliseconds{ 20 };
+        CHECK_EQ( l.poll(), 3 );
+        CHECK_EQ( log.size(), 4 );
+        CHECK_EQ( log.back(), 3 );
+
+        SUBCASE( "expired" )
+        {
+                fake_clock::current += std::chrono::milliseconds{ 10 };
+                CHECK_EQ( l.poll(), 1 );
+                CHECK_EQ( log.back(), 1 );
+                CHECK( l.empty() );
+        }
+
+        SUBCASE( "destroyed sleeper is unscheduled" )
+        {
+                {
+                        task tmp = std::move( t1 );
+                }
+                CHECK( l.empty() );
+        }
+}
+
+TEST_CASE( "run_loop_timer_storm" )
+{
+        fake_clock::current = {};
+        fake_loop           l;
+        std::vector< int >  log;
+        std::vector< task > tasks;
+        tasks.reserve( 20000 );
+        for ( int i = 0; i < 20000; ++i )
+                tasks.push_back( sleeping( l, log, ( i * 7919 ) % 1000, 1 + ( i * 7919 ) % 1000 ) );
+        CHECK( log.empty() );
+
+        // all of them expire in the same tick and resume in deadline order
+        fake_clock::current += std::chrono::milliseconds{ 1000 };
+        CHECK_EQ( l.poll(), 20000 );
+        CHECK_EQ( log.size(), 20000 );
+        CHECK( std::is_sorted( log.begin(), log.end() ) );
+        CHECK( l.empty() );
+}
+
+TEST_CASE( "run_loop_run" )
+{
+        run_loop           l;
+        std::vector< int > log;
+
+        task t1    = sleeping_steady( l, log, 1, 6 );
+        task t2    = sleeping_steady( l, log, 2, 2 );
+        task t3    = sleeping_steady( l, log, 3, 4 );
+        auto start = std::chrono::steady_clock::now();
+        l.run();
+        CHECK( std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{ 6 } );
+        CHECK_EQ( log, std::vector< int >{ 2, 3, 1 } );
+        CHECK( l.empty() );
+}
+
+}  // namespace zll
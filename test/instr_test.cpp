@@ -0,0 +1,156 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#define ZLL_DEFAULT_INSTRUMENT
+#include "zll.hpp"
+
+#include <doctest/doctest.h>
+
+namespace zll
+{
+namespace
+{
+
+struct ll_item : ll_base< ll_item >
+{
+        int value = 0;
+
+        ll_item( int v = 0 )
+          : value( v )
+        {
+        }
+
+        bool operator<( ll_item const& other ) const noexcept
+        {
+                return value < other.value;
+        }
+};
+
+struct sh_item : sh_base< sh_item >
+{
+        int value = 0;
+
+        sh_item( int v = 0 )
+          : value( v )
+        {
+        }
+
+        bool operator<( sh_item const& other ) const noexcept
+        {
+                return value < other.value;
+        }
+};
+
+struct ring_item : ll_ring_base< ring_item >
+{
+        int value = 0;
+
+        ring_item( int v = 0 )
+          : value( v )
+        {
+        }
+};
+
+}  // namespace
+
+TEST_CASE( "instrument" )
+{
+        using ll_counters   = instr_counters< ll_item >;
+        using sh_counters   = instr_counters< sh_item >;
+        using ring_counters = instr_counters< ring_item >;
+        ll_counters::reset();
+        sh_counters::reset();
+        ring_counters::reset();
+
+        SUBCASE( "list" )
+        {
+                ll_item            a( 3 ), b( 1 ), c( 2 ), d( 0 );
+                ll_list< ll_item > l;
+                l.link_back( a );
+                l.link_back( b );
+                l.link_back( c );
+                CHECK_EQ( ll_counters::get( instr_event::link ), 2 );
+
+                int sum = 0;
+                for ( ll_item& i : l )
+                        sum += i.value;
+                CHECK_EQ( sum, 6 );
+                CHECK_EQ( ll_counters::get( instr_event::iter_step ), 3 );
+
+                move_from_to( b, d );
+                CHECK_EQ( ll_counters::get( instr_event::move ), 1 );
+
+                auto detaches = ll_counters::get( instr_event::detach );
+                detach( d );
+                CHECK_EQ( ll_counters::get( instr_event::detach ), detaches + 1 );
+
+                // walks of length 3 and 2, both in bucket [2, 4)
+                l.link_back( b );
+                l.sort();
+                auto& walks =
+                    ll_counters::hist[static_cast< std::size_t >( instr_event::sort_walk )];
+                CHECK_EQ( ll_counters::get( instr_event::sort_walk ), 2 );
+                CHECK_EQ( walks[2].load(), 2 );
+        }
+
+        SUBCASE( "heap" )
+        {
+                sh_item            a( 3 ), b( 1 ), c( 2 );
+                sh_heap< sh_item > h;
+                h.link( a );
+                h.link( b );
+                h.link( c );
+                CHECK_GE( sh_counters::get( instr_event::merge_step ), 2 );
+
+                auto steps = sh_counters::get( instr_event::merge_step );
+                h.pop();
+                CHECK_GT( sh_counters::get( instr_event::merge_step ), steps );
+                CHECK_EQ( sh_counters::get( instr_event::link ), 0 );
+        }
+
+        SUBCASE( "ring" )
+        {
+                ring_item            a( 1 ), b( 2 ), c( 3 );
+                ll_ring< ring_item > r{ &a, &b, &c };
+
+                int sum = 0;
+                for ( auto it = r.end(); it != r.begin(); )
+                        sum += ( --it )->value;
+                CHECK_EQ( sum, 6 );
+                CHECK_EQ( ring_counters::get( instr_event::iter_step ), 3 );
+
+                for ( ring_item& i : r )
+                        sum += i.value;
+                CHECK_EQ( ring_counters::get( instr_event::iter_step ), 6 );
+        }
+
+        SUBCASE( "reset" )
+        {
+                ll_item            a;
+                ll_list< ll_item > l;
+                l.link_back( a );
+                detach( a );
+                ll_counters::reset();
+                CHECK_EQ( ll_counters::get( instr_event::detach ), 0 );
+        }
+}
+
+}  // namespace zll
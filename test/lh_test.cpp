@@ -0,0 +1,388 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "zll.hpp"
+
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+struct hdr_access
+{
+        static auto& get( auto& item ) noexcept
+        {
+                return item.hdr;
+        }
+};
+
+struct node_t
+{
+        lh_header< node_t, hdr_access > hdr;
+
+        using access = hdr_access;
+
+        int x;
+
+        node_t( int v = 0 )
+          : x( v )
+        {
+        }
+
+        node_t( node_t&& o ) noexcept
+          : x( o.x )
+        {
+                move_from_to< node_t, hdr_access >( o, *this );
+        }
+
+        node_t& operator=( node_t&& o ) noexcept
+        {
+                detach< node_t, hdr_access >( *this, std::less<>{} );
+                x = o.x;
+                move_from_to< node_t, hdr_access >( o, *this );
+                return *this;
+        }
+
+        bool operator<( node_t const& other ) const noexcept
+        {
+                return x < other.x;
+        }
+
+        ~node_t()
+        {
+                detach< node_t, hdr_access >( *this, std::less<>{} );
+        }
+};
+
+struct der : public lh_base< der >
+{
+        int x;
+
+        der( int v = 0 )
+          : x( v )
+        {
+        }
+
+        bool operator<( der const& other ) const noexcept
+        {
+                return x < other.x;
+        }
+};
+
+/// Checks parent links, heap property and leftist property, returns number of nodes.
+template < typename T, typename Acc = typename T::access >
+std::size_t check_tree( T& node )
+{
+        auto&       h     = Acc::get( node );
+        std::size_t count = 1;
+        if ( h.left ) {
+                CHECK_EQ( _node( Acc::get( *h.left ).parent ), &node );
+                CHECK_FALSE( *h.left < node );
+                count += check_tree( *h.left );
+        }
+        if ( h.right ) {
+                CHECK_EQ( _node( Acc::get( *h.right ).parent ), &node );
+                CHECK_FALSE( *h.right < node );
+                count += check_tree( *h.right );
+        }
+        CHECK( _lh_rank< T, Acc >( h.left ) >= _lh_rank< T, Acc >( h.right ) );
+        CHECK_EQ( h.rank, _lh_rank< T, Acc >( h.right ) + 1 );
+        return count;
+}
+
+template < typename T, typename Acc = typename T::access >
+std::size_t check_heap( lh_heap< T, Acc > const& h )
+{
+        if ( !h.top )
+                return 0;
+        CHECK_EQ( _heap( Acc::get( *h.top ).parent ), &h );
+        return check_tree( *h.top );
+}
+
+}  // namespace
+
+TEST_CASE_TEMPLATE( "lh_single", T, node_t, der )
+{
+        using access = typename T::access;
+
+        T                    d1{ 1 };
+        lh_heap< T, access > h;
+        h.link( d1 );
+        CHECK_EQ( h.top, &d1 );
+        CHECK_EQ( check_heap( h ), 1 );
+        CHECK_EQ( &h.take(), &d1 );
+        CHECK( h.empty() );
+        CHECK( ( detached< T, access >( d1 ) ) );
+}
+
+TEST_CASE_TEMPLATE( "lh_ordering", T, node_t, der )
+{
+        using access = typename T::access;
+
+        std::vector< T > nodes;
+        nodes.reserve( 64 );
+        for ( int i = 0; i < 64; i++ )
+                nodes.emplace_back( ( i * 37 ) % 64 );
+
+        lh_heap< T, access > h;
+        for ( auto& n : nodes )
+                h.link( n );
+        CHECK_EQ( check_heap( h ), 64 );
+
+        std::vector< int > res;
+        while ( !h.empty() ) {
+                res.push_back( h.take().x );
+                check_heap( h );
+        }
+        CHECK_EQ( res.size(), 64 );
+        CHECK( std::is_sorted( res.begin(), res.end() ) );
+}
+
+TEST_CASE_TEMPLATE( "lh_detach", T, node_t, der )
+{
+        using access = typename T::access;
+
+        std::vector< T > nodes;
+        nodes.reserve( 32 );
+        for ( int i = 0; i < 32; i++ )
+                nodes.emplace_back( i );
+
+        lh_heap< T, access > h;
+        for ( auto& n : nodes )
+                h.link( n );
+
+        std::set< int > expected;
+        for ( int i = 0; i < 32; i++ )
+                expected.insert( i );
+
+        for ( int i : { 17, 0, 31, 5, 6, 20 } ) {
+                detach< T, access >( nodes[static_cast< std::size_t >( i )], std::less<>{} );
+                expected.erase( i );
+                CHECK( ( detached< T, access >( nodes[static_cast< std::size_t >( i )] ) ) );
+                CHECK_EQ( check_heap( h ), expected.size() );
+        }
+
+        std::vector< int > res;
+        while ( !h.empty() )
+                res.push_back( h.take().x );
+        CHECK_EQ( res, std::vector< int >( expected.begin(), expected.end() ) );
+}
+
+TEST_CASE_TEMPLATE( "lh_move", T, node_t, der )
+{
+        using access = typename T::access;
+
+        T                    d1{ 1 }, d2{ 2 }, d3{ 3 };
+        lh_heap< T, access > h = { &d2, &d1, &d3 };
+
+        SUBCASE( "move top" )
+        {
+                T d4{ std::move( d1 ) };
+                CHECK_EQ( h.top, &d4 );
+                CHECK_EQ( check_heap( h ), 3 );
+        }
+
+        SUBCASE( "move inner" )
+        {
+                T d4{ std::move( d3 ) };
+                CHECK_EQ( check_heap( h ), 3 );
+                CHECK( ( detached< T, access >( d3 ) ) );
+        }
+
+        SUBCASE( "destroy" )
+        {
+                {
+                        T d4{ std::move( d1 ) };
+                }
+                CHECK_EQ( h.top, &d2 );
+                CHECK_EQ( check_heap( h ), 2 );
+        }
+
+        SUBCASE( "heap move" )
+        {
+                lh_heap< T, access > h2{ std::move( h ) };
+                CHECK( h.empty() );
+                CHECK_EQ( check_heap( h2 ), 3 );
+
+                h = std::move( h2 );
+                CHECK( h2.empty() );
+                CHECK_EQ( check_heap( h ), 3 );
+        }
+}
+
+TEST_CASE( "lh_copy" )
+{
+        der d1{ 1 }, d2{ 2 };
+
+        lh_heap< der > h = { &d2 };
+
+        der d3{ d2 };
+        CHECK_EQ( check_heap( h ), 2 );
+
+        d1 = d3;
+        CHECK_EQ( check_heap( h ), 3 );
+        CHECK_EQ( d1.x, 2 );
+        CHECK_EQ( h.top->x, 2 );
+}
+
+TEST_CASE( "lh_copy_distinct_keys" )
+{
+        std::vector< der > nodes;
+        nodes.reserve( 64 );
+        for ( int i = 0; i < 64; i++ )
+                nodes.emplace_back( ( i * 37 ) % 64 );
+        lh_heap< der > h;
+        for ( auto& n : nodes )
+                h.link( n );
+
+        std::vector< int > expected;
+        for ( auto& n : nodes )
+                expected.push_back( n.x );
+        {
+                // copies are linked without comparing their not yet copied keys
+                der c1{ nodes[5] };
+                der c2{ nodes[17] };
+                der a{ 1000 };
+                a = nodes[40];
+                expected.push_back( nodes[5].x );
+                expected.push_back( nodes[17].x );
+                expected.push_back( nodes[40].x );
+                CHECK_EQ( check_heap( h ), 67 );
+                CHECK_EQ( a.x, nodes[40].x );
+
+                der b{ 1000 };
+                h.link( b );
+                b = nodes[3];
+                expected.push_back( nodes[3].x );
+                CHECK_EQ( check_heap( h ), 68 );
+
+                std::ranges::sort( expected );
+                std::vector< int > out;
+                while ( !h.empty() )
+                        out.push_back( h.take().x );
+                CHECK_EQ( out, expected );
+        }
+}
+
+TEST_CASE( "lh_merge" )
+{
+        der d1{ 1 }, d2{ 2 }, d3{ 3 }, d4{ 4 };
+
+        SUBCASE( "empty into non-empty" )
+        {
+                lh_heap< der > h1 = { &d1, &d2 }, h2;
+                h1.merge( std::move( h2 ) );
+                CHECK( h2.empty() );
+                CHECK_EQ( check_heap( h1 ), 2 );
+        }
+
+        SUBCASE( "non-empty into empty" )
+        {
+                lh_heap< der > h1, h2 = { &d1, &d2 };
+                h1.merge( std::move( h2 ) );
+                CHECK( h2.empty() );
+                CHECK_EQ( check_heap( h1 ), 2 );
+        }
+
+        SUBCASE( "self" )
+        {
+                lh_heap< der > h1 = { &d1, &d2 };
+                h1.merge( std::move( h1 ) );
+                CHECK_EQ( check_heap( h1 ), 2 );
+        }
+
+        SUBCASE( "both" )
+        {
+                lh_heap< der > h1 = { &d4, &d1 }, h2 = { &d3, &d2 };
+                h1.merge( std::move( h2 ) );
+                CHECK( h2.empty() );
+                CHECK_EQ( check_heap( h1 ), 4 );
+                CHECK_EQ( h1.take().x, 1 );
+                CHECK_EQ( h1.take().x, 2 );
+                CHECK_EQ( h1.take().x, 3 );
+                CHECK_EQ( h1.take().x, 4 );
+        }
+}
+
+TEST_CASE( "lh_random" )
+{
+        std::vector< std::unique_ptr< der > > nodes;
+        lh_heap< der >                        h;
+
+        std::uint32_t seed = 42;
+        auto          rng  = [&] {
+                seed = seed * 1664525u + 1013904223u;
+                return seed >> 8;
+        };
+
+        for ( int i = 0; i < 2000; i++ ) {
+                switch ( rng() % 4 ) {
+                case 0:
+                case 1:
+                        nodes.push_back(
+                            std::make_unique< der >( static_cast< int >( rng() % 1000 ) ) );
+                        h.link( *nodes.back() );
+                        break;
+                case 2:
+                        if ( !h.empty() ) {
+                                der& t = h.take();
+                                CHECK( std::all_of( nodes.begin(), nodes.end(), [&]( auto& n ) {
+                                        return detached( *n ) || !( *n < t );
+                                } ) );
+                        }
+                        break;
+                case 3:
+                        if ( !nodes.empty() ) {
+                                auto idx = rng() % nodes.size();
+                                nodes.erase( nodes.begin() + static_cast< std::ptrdiff_t >( idx ) );
+                        }
+                        break;
+                }
+        }
+        check_heap( h );
+}
+
+TEST_CASE( "meld_all" )
+{
+        std::vector< der >             nodes;
+        std::vector< lh_heap< der > >  heaps( 6 );
+        std::vector< lh_heap< der >* > ptrs;
+        for ( int i = 0; i < 300; i++ )
+                nodes.emplace_back( ( i * 7919 ) % 997 );
+        for ( std::size_t i = 0; i < nodes.size(); i++ )
+                heaps[i % 5].link( nodes[i] );
+        for ( auto& h : heaps )
+                ptrs.push_back( &h );
+
+        auto& res = meld_all( std::span{ ptrs } );
+        CHECK_EQ( &res, &heaps[0] );
+        CHECK_EQ( check_heap( res ), nodes.size() );
+        for ( std::size_t i = 1; i < heaps.size(); i++ )
+                CHECK( heaps[i].empty() );
+}
+
+}  // namespace zll
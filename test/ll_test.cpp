@@ -23,9 +23,13 @@
 
 #include "zll.hpp"
 
+#include <algorithm>
 #include <doctest/doctest.h>
 #include <list>
+#include <ranges>
 #include <set>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace zll
@@ -136,8 +140,64 @@ void check_for_each_node( der& n, std::set< der const* > const& expected )
         CHECK_EQ( s2, expected );
 }
 
+constinit ll_list< der > static_list;
+constinit der            static_node;
+
+static_assert( [] {
+        ll_list< der > l;
+        return l.empty() && l.begin() == l.end();
+}() );
+
 }  // namespace
 
+TEST_CASE( "node_flags" )
+{
+        der a, b, c;
+        set_node_flags( a, 1 );
+        set_node_flags( b, 2 );
+        set_node_flags( c, 3 );
+        CHECK( detached( a ) );
+
+        ll_list< der > l;
+        l.link_back( a );
+        l.link_back( b );
+        l.link_back( c );
+        check_links( l.front() );
+        CHECK_EQ( node_flags( a ), 1 );
+        CHECK_EQ( node_flags( b ), 2 );
+        CHECK_EQ( node_flags( c ), 3 );
+
+        l.reverse();
+        CHECK_EQ( &l.front(), &c );
+        check_links( l.front() );
+        CHECK_EQ( node_flags( c ), 3 );
+
+        der d;
+        move_from_to( b, d );
+        CHECK_EQ( node_flags( d ), 0 );
+        CHECK_EQ( node_flags( b ), 2 );
+        CHECK( detached( b ) );
+
+        set_node_flags( d, 7 );
+        CHECK_EQ( node_flags( d ), 3 );
+        detach( d );
+        CHECK( detached( d ) );
+        CHECK_EQ( node_flags( d ), 3 );
+        CHECK_EQ( std::distance( l.begin(), l.end() ), 2 );
+}
+
+TEST_CASE( "constinit" )
+{
+        CHECK( static_list.empty() );
+        CHECK( detached( static_node ) );
+
+        static_list.link_back( static_node );
+        CHECK_EQ( &static_list.front(), &static_node );
+
+        detach( static_node );
+        CHECK( static_list.empty() );
+}
+
 TEST_CASE_TEMPLATE( "single", T, node_t, der )
 {
         using access = typename T::access;
@@ -1076,6 +1136,222 @@ TEST_CASE( "splice_functionality" )
         }
 }
 
+TEST_CASE( "clear" )
+{
+        der            d1, d2, d3;
+        ll_list< der > l = { &d1, &d2, &d3 };
+
+        SUBCASE( "clear detaches all nodes" )
+        {
+                set_node_flags( d2, 2 );
+                l.clear();
+                CHECK( l.empty() );
+                CHECK( detached( d1 ) );
+                CHECK( detached( d2 ) );
+                CHECK( detached( d3 ) );
+                CHECK_EQ( node_flags( d2 ), 2 );
+                l.clear();
+                CHECK( l.empty() );
+        }
+
+        SUBCASE( "clear_fast leaves a detached range" )
+        {
+                l.clear_fast();
+                CHECK( l.empty() );
+                CHECK( detached_range( d1, d3 ) );
+                CHECK_FALSE( detached( d2 ) );
+
+                ll_list< der > l2;
+                l2.link_range_back( d1, d3 );
+                check_list_ptr( l2, { &d1, &d2, &d3 } );
+        }
+
+        SUBCASE( "node of cleared range is destroyed" )
+        {
+                der d4;
+                l.link_back( d4 );
+                l.clear_fast();
+                {
+                        der tmp = std::move( d2 );
+                }
+                ll_list< der > l2;
+                l2.link_range_back( d1, d4 );
+                check_list_ptr( l2, { &d1, &d3, &d4 } );
+        }
+}
+
+static_assert( std::ranges::bidirectional_range< ll_list< der > > );
+static_assert( std::ranges::bidirectional_range< ll_list< der > const > );
+static_assert( std::bidirectional_iterator< ll_iterator< der > > );
+static_assert( std::bidirectional_iterator< ll_const_iterator< der > > );
+
+TEST_CASE( "ranges" )
+{
+        std::vector< der > nodes( 10 );
+        ll_list< der >     l;
+        for ( auto& n : nodes )
+                l.link_back( n );
+
+        SUBCASE( "reverse" )
+        {
+                std::vector< der const* > rev;
+                for ( der const& d : std::views::reverse( std::as_const( l ) ) )
+                        rev.push_back( &d );
+                CHECK_EQ( rev.size(), nodes.size() );
+                CHECK_EQ( rev.front(), &nodes.back() );
+                CHECK_EQ( rev.back(), &nodes.front() );
+                CHECK_EQ( &*std::prev( l.end() ), &l.back() );
+        }
+
+        SUBCASE( "filter and take" )
+        {
+                auto odd = l | std::views::filter( [&]( der const& d ) {
+                                   return ( &d - nodes.data() ) % 2 == 1;
+                           } ) |
+                           std::views::take( 3 );
+                std::vector< der const* > res;
+                for ( der const& d : odd )
+                        res.push_back( &d );
+                CHECK_EQ( res, std::vector< der const* >{ &nodes[1], &nodes[3], &nodes[5] } );
+        }
+
+        SUBCASE( "algorithms" )
+        {
+                auto it = std::ranges::find( l, &nodes[4], []( der& d ) {
+                        return &d;
+                } );
+                CHECK_EQ( it.get(), &nodes[4] );
+                CHECK_EQ( std::ranges::distance( l.begin(), l.end() ), 10 );
+                CHECK( std::ranges::next( l.begin(), 10 ) == std::default_sentinel );
+        }
+
+        SUBCASE( "decrement from end of iterator walked off the list" )
+        {
+                ll_list< der >::iterator it{ &nodes[8] };
+                ++it;
+                ++it;
+                CHECK( it == l.end() );
+                --it;
+                CHECK_EQ( it.get(), &nodes[9] );
+        }
+}
+
+TEST_CASE( "merge_all" )
+{
+        struct keyed : public ll_base< keyed >
+        {
+                int value = 0;
+                int list  = 0;
+
+                bool operator<( keyed const& other ) const noexcept
+                {
+                        return value < other.value;
+                }
+        };
+
+        for ( std::size_t k : { 1u, 2u, 3u, 7u, 8u } ) {
+                std::vector< keyed >             nodes( k * 20 );
+                std::vector< ll_list< keyed > >  lists( k );
+                std::vector< ll_list< keyed >* > ptrs;
+                for ( std::size_t i = 0; i < nodes.size(); i++ ) {
+                        nodes[i].value = static_cast< int >( i % 20 ) / 2;
+                        nodes[i].list  = static_cast< int >( i / 20 );
+                        lists[i / 20].link_back( nodes[i] );
+                }
+                for ( auto& l : lists )
+                        ptrs.push_back( &l );
+
+                auto& res = merge_all( std::span{ ptrs } );
+                CHECK_EQ( &res, &lists[0] );
+                for ( std::size_t i = 1; i < k; i++ )
+                        CHECK( lists[i].empty() );
+
+                check_links( res.front() );
+                std::size_t  count  = 0;
+                std::size_t  broken = 0;
+                keyed const* prev   = nullptr;
+                for ( keyed const& n : res ) {
+                        if ( prev && ( n < *prev || ( !( *prev < n ) && n.list < prev->list ) ) )
+                                ++broken;
+                        prev = &n;
+                        ++count;
+                }
+                CHECK_EQ( count, nodes.size() );
+                CHECK_EQ( broken, 0 );
+                CHECK_EQ( &res.back(), prev );
+        }
+}
+
+TEST_CASE( "splice_range" )
+{
+        der            d1, d2, d3, d4, d5, d6;
+        ll_list< der > l1 = { &d1, &d2 }, l2 = { &d3, &d4, &d5, &d6 };
+
+        SUBCASE( "middle range before position" )
+        {
+                l1.splice( std::next( l1.begin() ), l2, std::next( l2.begin() ), l2.end() );
+                check_list_ptr( l1, { &d1, &d4, &d5, &d6, &d2 } );
+                check_list_ptr( l2, { &d3 } );
+        }
+
+        SUBCASE( "range to the end" )
+        {
+                l1.splice( l1.end(), l2, l2.begin(), std::next( l2.begin(), 2 ) );
+                check_list_ptr( l1, { &d1, &d2, &d3, &d4 } );
+                check_list_ptr( l2, { &d5, &d6 } );
+        }
+
+        SUBCASE( "whole list into empty one" )
+        {
+                ll_list< der > l3;
+                l3.splice( l3.end(), l2, l2.begin(), l2.end() );
+                CHECK( l2.empty() );
+                check_list_ptr( l3, { &d3, &d4, &d5, &d6 } );
+        }
+
+        SUBCASE( "empty range" )
+        {
+                l1.splice( l1.begin(), l2, l2.begin(), l2.begin() );
+                check_list_ptr( l1, { &d1, &d2 } );
+                check_list_ptr( l2, { &d3, &d4, &d5, &d6 } );
+        }
+
+        SUBCASE( "within one list" )
+        {
+                l2.splice( l2.begin(), l2, std::next( l2.begin(), 2 ), l2.end() );
+                check_list_ptr( l2, { &d5, &d6, &d3, &d4 } );
+        }
+}
+
+TEST_CASE( "split_after" )
+{
+        der            d1, d2, d3, d4;
+        ll_list< der > l = { &d1, &d2, &d3, &d4 };
+
+        SUBCASE( "middle" )
+        {
+                ll_list< der > r = l.split_after( std::next( l.begin() ) );
+                check_list_ptr( l, { &d1, &d2 } );
+                check_list_ptr( r, { &d3, &d4 } );
+        }
+
+        SUBCASE( "last node" )
+        {
+                ll_list< der > r = l.split_after( std::next( l.begin(), 3 ) );
+                CHECK( r.empty() );
+                check_list_ptr( l, { &d1, &d2, &d3, &d4 } );
+        }
+
+        SUBCASE( "first node" )
+        {
+                ll_list< der > r = l.split_after( l.begin() );
+                check_list_ptr( l, { &d1 } );
+                check_list_ptr( r, { &d2, &d3, &d4 } );
+                l.splice( l.end(), std::move( r ) );
+                check_list_ptr( l, { &d1, &d2, &d3, &d4 } );
+        }
+}
+
 TEST_CASE( "remove_functionality" )
 {
         struct removable_node : public ll_base< removable_node >
@@ -1639,6 +1915,20 @@ TEST_CASE( "sort_functionality" )
                 CHECK_EQ( &l.back(), &n3 );
         }
 
+        SUBCASE( "sort when last node goes below pivot" )
+        {
+                sortable_node            n1( 12 ), n2( 15 ), n3( 53 ), n4( 12 ), n5( 6 );
+                ll_list< sortable_node > l = { &n1, &n2, &n3, &n4, &n5 };
+                l.sort();
+
+                std::vector< int > sorted_values;
+                for ( auto const& node : l )
+                        sorted_values.push_back( node.value );
+                CHECK_EQ( sorted_values, std::vector< int >{ 6, 12, 12, 15, 53 } );
+                CHECK_EQ( &l.front(), &n5 );
+                CHECK_EQ( &l.back(), &n3 );
+        }
+
         SUBCASE( "sort with duplicates" )
         {
                 sortable_node            n1( 3 ), n2( 1 ), n3( 3 ), n4( 2 ), n5( 1 );
@@ -1814,4 +2104,223 @@ TEST_CASE( "sort_functionality" )
         }
 }
 
+TEST_CASE( "insert_sorted_functionality" )
+{
+        struct sorted_node : public ll_base< sorted_node >
+        {
+                int value;
+                int id;
+
+                sorted_node( int v = 0, int i = 0 )
+                  : value( v )
+                  , id( i )
+                {
+                }
+
+                bool operator<( sorted_node const& other ) const
+                {
+                        return value < other.value;
+                }
+        };
+
+        auto check_sorted = []( ll_list< sorted_node > const& l, std::size_t n ) {
+                check_links( l.front() );
+                std::vector< int > values;
+                for ( auto const& node : l )
+                        values.push_back( node.value );
+                CHECK_EQ( values.size(), n );
+                CHECK( std::is_sorted( values.begin(), values.end() ) );
+        };
+
+        SUBCASE( "insert into empty list" )
+        {
+                sorted_node            n1( 1 );
+                ll_list< sorted_node > l;
+                auto                   it = l.insert_sorted( n1 );
+                CHECK_EQ( it.get(), &n1 );
+                CHECK_EQ( &l.front(), &n1 );
+                CHECK_EQ( &l.back(), &n1 );
+        }
+
+        SUBCASE( "insert without hint" )
+        {
+                std::vector< sorted_node > nodes;
+                for ( int v : { 5, 3, 9, 1, 7, 3, 10, 0 } )
+                        nodes.emplace_back( v );
+                ll_list< sorted_node > l;
+                for ( auto& n : nodes )
+                        l.insert_sorted( n );
+                check_sorted( l, nodes.size() );
+                CHECK_EQ( l.front().value, 0 );
+                CHECK_EQ( l.back().value, 10 );
+        }
+
+        SUBCASE( "insert with hint in both directions" )
+        {
+                sorted_node            n1( 1 ), n3( 3 ), n5( 5 ), n7( 7 );
+                ll_list< sorted_node > l = { &n1, &n3, &n5, &n7 };
+
+                sorted_node n0( 0 ), n4( 4 ), n6( 6 ), n8( 8 );
+                auto        hint = ll_list< sorted_node >::iterator{ &n5 };
+                l.insert_sorted( hint, n4 );
+                l.insert_sorted( hint, n6 );
+                l.insert_sorted( hint, n0 );
+                l.insert_sorted( hint, n8 );
+                check_list_ptr( l, { &n0, &n1, &n3, &n4, &n5, &n6, &n7, &n8 } );
+        }
+
+        SUBCASE( "equal elements are inserted after existing ones" )
+        {
+                sorted_node            a( 2, 1 ), b( 2, 2 ), c( 2, 3 ), d( 1, 4 ), e( 3, 5 );
+                ll_list< sorted_node > l = { &d, &a, &e };
+                l.insert_sorted( ll_list< sorted_node >::iterator{ &e }, b );
+                l.insert_sorted( ll_list< sorted_node >::iterator{ &d }, c );
+                check_list_ptr( l, { &d, &a, &b, &c, &e } );
+        }
+
+        SUBCASE( "reinsert node used as hint" )
+        {
+                sorted_node            n1( 1 ), n2( 2 ), n3( 3 );
+                ll_list< sorted_node > l = { &n1, &n2, &n3 };
+
+                n2.value = 10;
+                auto it  = l.insert_sorted( ll_list< sorted_node >::iterator{ &n2 }, n2 );
+                CHECK_EQ( it.get(), &n2 );
+                CHECK_EQ( std::next( it ), l.end() );
+                CHECK_EQ( std::prev( std::next( it ) ), it );
+                check_list_ptr( l, { &n1, &n3, &n2 } );
+
+                n2.value = 0;
+                l.insert_sorted( l.end(), n2 );
+                check_list_ptr( l, { &n2, &n1, &n3 } );
+        }
+
+        SUBCASE( "ascending arrivals with returned hint" )
+        {
+                std::vector< sorted_node > nodes;
+                for ( int i = 0; i < 50; i++ )
+                        nodes.emplace_back( i / 3 );
+                ll_list< sorted_node > l;
+                auto                   hint = l.end();
+                for ( auto& n : nodes )
+                        hint = l.insert_sorted( hint, n, std::less<>{} );
+                check_sorted( l, nodes.size() );
+        }
+
+        SUBCASE( "batch insert" )
+        {
+                sorted_node            n1( 1 ), n4( 4 ), n8( 8 );
+                ll_list< sorted_node > l = { &n1, &n4, &n8 };
+
+                sorted_node            m9( 9 ), m0( 0 ), m5( 5 ), m4( 4 );
+                ll_list< sorted_node > batch = { &m9, &m0, &m5, &m4 };
+                l.insert_sorted( std::move( batch ) );
+                CHECK( batch.empty() );
+                check_list_ptr( l, { &m0, &n1, &n4, &m4, &m5, &n8, &m9 } );
+        }
+
+        SUBCASE( "large presorted batch" )
+        {
+                // bottom-up merge sort, the batch neither degrades to O(n^2) nor recurses
+                std::vector< sorted_node > nodes;
+                for ( int i = 0; i < 200000; i++ )
+                        nodes.emplace_back( i / 4, i );
+                ll_list< sorted_node > l, batch;
+                for ( auto& n : nodes )
+                        batch.link_back( n );
+                l.insert_sorted( std::move( batch ) );
+                CHECK( batch.empty() );
+                int  id       = 0;
+                bool in_order = true;
+                for ( auto const& node : l )
+                        in_order = in_order && node.id == id++;
+                CHECK( in_order );
+                CHECK_EQ( id, 200000 );
+        }
+}
+
+struct by_conn;
+struct by_worker;
+struct by_lru;
+
+struct multi : ll_multi_base< multi, by_conn, by_worker, by_lru >
+{
+        int id = 0;
+
+        multi( int i )
+          : id( i )
+        {
+        }
+};
+
+template < typename Tag >
+std::vector< int > multi_ids( ll_list< multi, tag_access< Tag > > const& l )
+{
+        std::vector< int > res;
+        multi const*       prev = nullptr;
+        for ( multi const& m : l ) {
+                CHECK_EQ( _node( tag_access< Tag >::get( m ).prev ), prev );
+                res.push_back( m.id );
+                prev = &m;
+        }
+        if ( !l.empty() )
+                CHECK_EQ( &l.back(), prev );
+        return res;
+}
+
+TEST_CASE( "multi_base" )
+{
+        ll_list< multi, tag_access< by_conn > >   conn;
+        ll_list< multi, tag_access< by_worker > > worker;
+        ll_list< multi, tag_access< by_lru > >    lru;
+
+        multi m1( 1 ), m2( 2 ), m3( 3 );
+        conn.link_back( m1 );
+        conn.link_back( m2 );
+        conn.link_back( m3 );
+        worker.link_back( m3 );
+        worker.link_back( m1 );
+        lru.link_back( m2 );
+        lru.link_back( m1 );
+        CHECK( m2.linked< by_lru >() );
+        CHECK_FALSE( m2.linked< by_worker >() );
+
+        SUBCASE( "move fixes all memberships" )
+        {
+                multi m4 = std::move( m1 );
+                m4.id    = 4;
+                CHECK_EQ( multi_ids( conn ), std::vector< int >{ 4, 2, 3 } );
+                CHECK_EQ( multi_ids( worker ), std::vector< int >{ 3, 4 } );
+                CHECK_EQ( multi_ids( lru ), std::vector< int >{ 2, 4 } );
+                CHECK_FALSE( m1.linked< by_conn >() );
+                CHECK_FALSE( m1.linked< by_lru >() );
+        }
+
+        SUBCASE( "destruction unlinks from all lists" )
+        {
+                {
+                        multi tmp = std::move( m1 );
+                }
+                CHECK_EQ( multi_ids( conn ), std::vector< int >{ 2, 3 } );
+                CHECK_EQ( multi_ids( worker ), std::vector< int >{ 3 } );
+                CHECK_EQ( multi_ids( lru ), std::vector< int >{ 2 } );
+        }
+
+        SUBCASE( "detach_all" )
+        {
+                m2.detach_all();
+                CHECK_EQ( multi_ids( conn ), std::vector< int >{ 1, 3 } );
+                CHECK_EQ( multi_ids( lru ), std::vector< int >{ 1 } );
+        }
+
+        SUBCASE( "lists are independent" )
+        {
+                detach< multi, tag_access< by_worker > >( m3 );
+                lru.link_front( m3 );
+                CHECK_EQ( multi_ids( conn ), std::vector< int >{ 1, 2, 3 } );
+                CHECK_EQ( multi_ids( worker ), std::vector< int >{ 1 } );
+                CHECK_EQ( multi_ids( lru ), std::vector< int >{ 3, 2, 1 } );
+        }
+}
+
 }  // namespace zll
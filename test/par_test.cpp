@@ -0,0 +1,413 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "zll_parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <doctest/doctest.h>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+
+struct item : ll_base< item >
+{
+        int value = 0;
+        int id    = 0;
+
+        item( int v = 0, int i = 0 )
+          : value( v )
+          , id( i )
+        {
+        }
+
+        bool operator<( item const& other ) const noexcept
+        {
+                return value < other.value;
+        }
+};
+
+void check_sorted( ll_list< item > const& l, std::size_t n )
+{
+        std::size_t count  = 0;
+        std::size_t broken = 0;
+        item const* prev   = nullptr;
+        for ( item const& i : l ) {
+                if ( prev && ( i < *prev || ( prev->value == i.value && i.id < prev->id ) ) )
+                        ++broken;
+                if ( _node( item::access::get( i ).prev ) != prev )
+                        ++broken;
+                prev = &i;
+                ++count;
+        }
+        CHECK_EQ( broken, 0 );
+        CHECK_EQ( count, n );
+        if ( n > 0 )
+                CHECK_EQ( &l.back(), prev );
+}
+
+std::vector< item > make_items( std::size_t n, int mod )
+{
+        std::vector< item > res;
+        res.reserve( n );
+        std::uint32_t seed = 1;
+        for ( std::size_t i = 0; i < n; i++ ) {
+                seed = seed * 1664525u + 1013904223u;
+                auto v = ( seed >> 8 ) % static_cast< std::uint32_t >( mod );
+                res.emplace_back( static_cast< int >( v ), static_cast< int >( i ) );
+        }
+        return res;
+}
+
+void check_list_ptr( ll_list< item > const& l, std::vector< item > const& items )
+{
+        std::size_t i      = 0;
+        std::size_t broken = 0;
+        for ( item const& x : l )
+                if ( i >= items.size() || &x != &items[i++] )
+                        ++broken;
+        CHECK_EQ( broken, 0 );
+        CHECK_EQ( i, items.size() );
+}
+
+/// Node of binary tree of tasks, running a node submits its children.
+struct fan_task : ws_task
+{
+        ws_scheduler*               sched = nullptr;
+        std::vector< fan_task >*    tree  = nullptr;
+        std::size_t                 index = 0;
+        std::atomic< std::size_t >* runs  = nullptr;
+        std::thread::id             thread;
+
+        fan_task()
+          : ws_task( []( ws_task& t ) {
+                  auto& self  = static_cast< fan_task& >( t );
+                  self.thread = std::this_thread::get_id();
+                  self.runs->fetch_add( 1 );
+                  for ( std::size_t c : { 2 * self.index + 1, 2 * self.index + 2 } )
+                          if ( c < self.tree->size() )
+                                  self.sched->submit( ( *self.tree )[c] );
+          } )
+        {
+        }
+};
+
+struct flag_task : ws_task
+{
+        std::atomic< bool >* gate = nullptr;
+        int                  runs = 0;
+
+        flag_task()
+          : ws_task( []( ws_task& t ) {
+                  auto& self = static_cast< flag_task& >( t );
+                  while ( self.gate && !self.gate->load() )
+                          std::this_thread::yield();
+                  ++self.runs;
+          } )
+        {
+        }
+};
+
+/// One byte lock blocking on `parking_lot`, bit 0 is locked and bit 1 marks parked threads.
+struct byte_lock
+{
+        std::atomic< std::uint8_t > state = 0;
+
+        void lock() noexcept
+        {
+                for ( ;; ) {
+                        std::uint8_t s = state.load();
+                        if ( !( s & 1 ) ) {
+                                if ( state.compare_exchange_weak( s, s | 1 ) )
+                                        return;
+                                continue;
+                        }
+                        if ( !( s & 2 ) && !state.compare_exchange_weak( s, s | 2 ) )
+                                continue;
+                        parking_lot::park( &state, [&] {
+                                return state.load() == 3;
+                        } );
+                }
+        }
+
+        void unlock() noexcept
+        {
+                std::uint8_t s = 1;
+                if ( state.compare_exchange_strong( s, 0 ) )
+                        return;
+                parking_lot::unpark_one( &state, [&]( bool have_more ) {
+                        state.store( have_more ? 2 : 0 );
+                } );
+        }
+};
+
+}  // namespace
+
+TEST_CASE( "parallel_sort" )
+{
+        SUBCASE( "empty" )
+        {
+                ll_list< item > l;
+                parallel_sort( l );
+                CHECK( l.empty() );
+        }
+
+        SUBCASE( "small list is sorted inline" )
+        {
+                auto            items = make_items( 100, 10 );
+                ll_list< item > l;
+                for ( auto& i : items )
+                        l.link_back( i );
+                parallel_sort( l, std::less<>{}, 4 );
+                check_sorted( l, items.size() );
+        }
+
+        SUBCASE( "large list on multiple threads" )
+        {
+                for ( std::size_t threads : { 1u, 2u, 3u, 5u, 8u } ) {
+                        auto            items = make_items( 50'000, 1000 );
+                        ll_list< item > l;
+                        for ( auto& i : items )
+                                l.link_back( i );
+                        parallel_sort( l, std::less<>{}, threads );
+                        check_sorted( l, items.size() );
+                }
+        }
+
+        SUBCASE( "already sorted input" )
+        {
+                std::vector< item > items;
+                items.reserve( 40'000 );
+                for ( int i = 0; i < 40'000; i++ )
+                        items.emplace_back( i, i );
+                ll_list< item > l;
+                for ( auto& i : items )
+                        l.link_back( i );
+                parallel_sort( l, std::less<>{}, 4 );
+                check_sorted( l, items.size() );
+        }
+
+        SUBCASE( "custom comparator" )
+        {
+                auto            items = make_items( 20'000, 100 );
+                ll_list< item > l;
+                for ( auto& i : items )
+                        l.link_back( i );
+                parallel_sort(
+                    l,
+                    []( item const& a, item const& b ) {
+                            return a.value > b.value;
+                    },
+                    3 );
+                CHECK( std::is_sorted( l.begin(), l.end(), []( item const& a, item const& b ) {
+                        return a.value > b.value;
+                } ) );
+        }
+}
+
+TEST_CASE( "parallel_for_each" )
+{
+        SUBCASE( "empty" )
+        {
+                ll_list< item > l;
+                int             calls = 0;
+                parallel_for_each( l, [&]( item& ) {
+                        ++calls;
+                } );
+                CHECK_EQ( calls, 0 );
+        }
+
+        SUBCASE( "each node visited once" )
+        {
+                for ( std::size_t n : { 1u, 100u, 1000u, 12'345u } ) {
+                        for ( std::size_t threads : { 1u, 2u, 3u, 8u } ) {
+                                auto            items = make_items( n, 10 );
+                                ll_list< item > l;
+                                for ( auto& i : items )
+                                        l.link_back( i );
+                                parallel_for_each(
+                                    l,
+                                    []( item& i ) {
+                                            i.value += 1000;
+                                    },
+                                    threads );
+                                auto expected = make_items( n, 10 );
+                                bool ok       = true;
+                                for ( std::size_t i = 0; i < n; i++ )
+                                        ok = ok && items[i].value == expected[i].value + 1000;
+                                CHECK( ok );
+                                check_list_ptr( l, items );
+                        }
+                }
+        }
+
+        SUBCASE( "custom executor" )
+        {
+                auto            items = make_items( 10'000, 10 );
+                ll_list< item > l;
+                for ( auto& i : items )
+                        l.link_back( i );
+
+                std::vector< int > seen;
+                std::size_t        tasks = 0;
+                parallel_for_each(
+                    l,
+                    [&]( item& i ) {
+                            seen.push_back( i.id );
+                    },
+                    5,
+                    [&]( std::size_t k, auto& task ) {
+                            tasks = k;
+                            for ( std::size_t i = 0; i < k; i++ )
+                                    task( i );
+                    } );
+                CHECK_EQ( tasks, 5 );
+                REQUIRE_EQ( seen.size(), items.size() );
+                bool ok = true;
+                for ( std::size_t i = 0; i < seen.size(); i++ )
+                        ok = ok && seen[i] == static_cast< int >( i );
+                CHECK( ok );
+        }
+}
+
+TEST_CASE( "ws_scheduler" )
+{
+        SUBCASE( "fan-out runs every task once" )
+        {
+                for ( std::size_t threads : { 1u, 2u, 4u } ) {
+                        ws_scheduler               s{ threads };
+                        std::vector< fan_task >    tree( 10'000 );
+                        std::atomic< std::size_t > runs = 0;
+                        for ( std::size_t i = 0; i < tree.size(); i++ ) {
+                                tree[i].sched = &s;
+                                tree[i].tree  = &tree;
+                                tree[i].index = i;
+                                tree[i].runs  = &runs;
+                        }
+                        s.submit( tree[0] );
+                        s.wait_idle();
+                        CHECK_EQ( runs.load(), tree.size() );
+                        std::size_t on_caller = 0;
+                        for ( auto& t : tree )
+                                on_caller += t.thread == std::this_thread::get_id();
+                        CHECK_EQ( on_caller, 0 );
+                }
+        }
+
+        SUBCASE( "destroyed task is cancelled" )
+        {
+                ws_scheduler        s{ 1 };
+                std::atomic< bool > gate = false;
+                flag_task           blocker;
+                blocker.gate = &gate;
+                flag_task kept;
+                s.submit( blocker );
+                s.submit( kept );
+                {
+                        flag_task dropped;
+                        s.submit( dropped );
+                }
+                flag_task cancelled;
+                s.submit( cancelled );
+                CHECK( cancelled.cancel() );
+                CHECK_FALSE( cancelled.cancel() );
+                gate.store( true );
+                s.wait_idle();
+                CHECK_EQ( blocker.runs, 1 );
+                CHECK_EQ( kept.runs, 1 );
+                CHECK_EQ( cancelled.runs, 0 );
+        }
+
+        SUBCASE( "destructor drains queued tasks" )
+        {
+                std::vector< flag_task > tasks( 100 );
+                {
+                        ws_scheduler s{ 2 };
+                        for ( auto& t : tasks )
+                                s.submit( t );
+                }
+                std::size_t runs = 0;
+                for ( auto& t : tasks )
+                        runs += static_cast< std::size_t >( t.runs );
+                CHECK_EQ( runs, tasks.size() );
+        }
+}
+
+TEST_CASE( "parking_lot" )
+{
+        SUBCASE( "failed validation does not park" )
+        {
+                int x = 0;
+                CHECK_FALSE( parking_lot::park( &x, [] {
+                        return false;
+                } ) );
+                CHECK_FALSE( parking_lot::unpark_one( &x ) );
+                CHECK_EQ( parking_lot::unpark_all( &x ), 0 );
+        }
+
+        SUBCASE( "unpark_all" )
+        {
+                std::atomic< int >         gate   = 0;
+                std::atomic< std::size_t > parked = 0;
+                std::vector< std::thread > ts;
+                for ( int i = 0; i < 4; i++ )
+                        ts.emplace_back( [&] {
+                                parking_lot::park( &gate, [&] {
+                                        ++parked;
+                                        return gate.load() == 0;
+                                } );
+                        } );
+                while ( parked.load() < 4 )
+                        std::this_thread::yield();
+                gate.store( 1 );
+                std::size_t woken = 0;
+                while ( woken < 4 )
+                        woken += parking_lot::unpark_all( &gate );
+                for ( auto& t : ts )
+                        t.join();
+                CHECK_EQ( woken, 4 );
+        }
+
+        SUBCASE( "byte lock" )
+        {
+                static_assert( sizeof( byte_lock ) == 1 );
+                byte_lock                  m;
+                std::size_t                counter = 0;
+                std::vector< std::thread > ts;
+                for ( int i = 0; i < 4; i++ )
+                        ts.emplace_back( [&] {
+                                for ( int j = 0; j < 10'000; j++ ) {
+                                        m.lock();
+                                        ++counter;
+                                        m.unlock();
+                                }
+                        } );
+                for ( auto& t : ts )
+                        t.join();
+                CHECK_EQ( counter, 40'000 );
+                CHECK_EQ( m.state.load(), 0 );
+        }
+}
+
+}  // namespace zll
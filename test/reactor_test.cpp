@@ -0,0 +1,171 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#if __has_include( <sys/epoll.h> )
+
+#include "zll_reactor.hpp"
+
+#include <doctest/doctest.h>
+#include <utility>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+
+using event_log = std::vector< std::pair< int, std::uint32_t > >;
+
+/// Pipe whose read end is watched by the handler, every dispatch is recorded into `log`.
+struct pipe_handler : fd_handler
+{
+        int        fds[2] = { -1, -1 };
+        int        id     = 0;
+        event_log* log    = nullptr;
+
+        pipe_handler( int i, event_log& l )
+          : fd_handler( []( fd_handler& h, std::uint32_t ev ) {
+                  auto& self = static_cast< pipe_handler& >( h );
+                  self.log->emplace_back( self.id, ev );
+                  char buf[16];
+                  if ( ev & EPOLLIN )
+                          CHECK( ::read( self.fds[0], buf, sizeof( buf ) ) > 0 );
+          } )
+          , id( i )
+          , log( &l )
+        {
+                REQUIRE_EQ( ::pipe( fds ), 0 );
+        }
+
+        void signal()
+        {
+                CHECK_EQ( ::write( fds[1], "x", 1 ), 1 );
+        }
+
+        ~pipe_handler()
+        {
+                ::close( fds[0] );
+                ::close( fds[1] );
+        }
+};
+
+}  // namespace
+
+TEST_CASE( "reactor" )
+{
+        reactor r;
+        REQUIRE_FALSE( r.error() );
+        event_log    log;
+        pipe_handler a{ 1, log };
+        pipe_handler b{ 2, log };
+        REQUIRE_FALSE( r.add( a, a.fds[0], EPOLLIN ) );
+        REQUIRE_FALSE( r.add( b, b.fds[0], EPOLLIN ) );
+        CHECK_EQ( r.size(), 2 );
+        CHECK_EQ( a.fd(), a.fds[0] );
+
+        SUBCASE( "nothing ready" )
+        {
+                CHECK_EQ( r.run_once( 0 ), 0 );
+                CHECK( log.empty() );
+        }
+
+        SUBCASE( "ready handlers are dispatched in one batch" )
+        {
+                a.signal();
+                b.signal();
+                CHECK_EQ( r.run_once( 0 ), 2 );
+                CHECK_EQ( log.size(), 2 );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+        }
+
+        SUBCASE( "timeout" )
+        {
+                r.set_timeout( a, std::chrono::milliseconds{ 5 } );
+                r.set_timeout( b, std::chrono::milliseconds{ 1 } );
+                auto start = fd_handler::clock::now();
+                CHECK_EQ( r.run_once(), 1 );
+                CHECK( fd_handler::clock::now() - start >= std::chrono::milliseconds{ 1 } );
+                CHECK_EQ( log, event_log{ { 2, 0 } } );
+                CHECK_EQ( r.run_once(), 1 );
+                CHECK_EQ( log, event_log{ { 2, 0 }, { 1, 0 } } );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+        }
+
+        SUBCASE( "far timeout does not override max_wait" )
+        {
+                r.set_timeout( a, std::chrono::hours{ 24 * 30 } );
+                auto start = fd_handler::clock::now();
+                CHECK_EQ( r.run_once( 1 ), 0 );
+                CHECK( fd_handler::clock::now() - start < std::chrono::seconds{ 10 } );
+                CHECK( log.empty() );
+        }
+
+        SUBCASE( "event and expired timeout are dispatched once" )
+        {
+                r.set_timeout( a, fd_handler::clock::now() );
+                a.signal();
+                CHECK_EQ( r.run_once( 0 ), 1 );
+                CHECK_EQ( log, event_log{ { 1, EPOLLIN } } );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+        }
+
+        SUBCASE( "cancelled timeout" )
+        {
+                r.set_timeout( a, fd_handler::clock::now() );
+                r.cancel_timeout( a );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+        }
+
+        SUBCASE( "destroyed handler is unregistered" )
+        {
+                {
+                        pipe_handler c{ 3, log };
+                        REQUIRE_FALSE( r.add( c, c.fds[0], EPOLLIN ) );
+                        r.set_timeout( c, fd_handler::clock::now() );
+                        c.signal();
+                }
+                CHECK_EQ( r.size(), 2 );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+                CHECK( log.empty() );
+        }
+
+        SUBCASE( "removed handler" )
+        {
+                r.remove( b );
+                CHECK_EQ( b.fd(), -1 );
+                b.signal();
+                CHECK_EQ( r.run_once( 0 ), 0 );
+                CHECK_EQ( r.size(), 1 );
+        }
+
+        SUBCASE( "modify" )
+        {
+                CHECK_FALSE( r.modify( a, EPOLLIN | EPOLLONESHOT ) );
+                a.signal();
+                a.signal();
+                CHECK_EQ( r.run_once( 0 ), 1 );
+                CHECK_EQ( r.run_once( 0 ), 0 );
+        }
+}
+
+}  // namespace zll
+
+#endif
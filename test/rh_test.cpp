@@ -0,0 +1,188 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "zll.hpp"
+
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+
+struct timer : ll_base< timer >
+{
+        std::uint64_t deadline;
+
+        timer( std::uint64_t d = 0 )
+          : deadline( d )
+        {
+        }
+
+        std::uint64_t key() const noexcept
+        {
+                return deadline;
+        }
+};
+
+struct deadline_of
+{
+        std::uint64_t operator()( timer const& t ) const noexcept
+        {
+                return t.deadline;
+        }
+};
+
+}  // namespace
+
+TEST_CASE( "radix_heap_basic" )
+{
+        radix_heap< timer > h;
+        CHECK( h.empty() );
+        CHECK_EQ( h.top(), nullptr );
+
+        SUBCASE( "single" )
+        {
+                timer t1{ 42 };
+                h.link( t1 );
+                CHECK_FALSE( h.empty() );
+                CHECK_EQ( h.top(), &t1 );
+                CHECK_EQ( h.last_key(), 42 );
+                CHECK_EQ( &h.take(), &t1 );
+                CHECK( h.empty() );
+                CHECK( detached( t1 ) );
+        }
+
+        SUBCASE( "sorted extraction" )
+        {
+                timer ts[] = { { 5 }, { 2 }, { 4 }, { 1 }, { 3 }, { 1 }, { 1000 }, { 0 } };
+                for ( auto& t : ts )
+                        h.link( t );
+
+                std::vector< std::uint64_t > res;
+                while ( !h.empty() )
+                        res.push_back( h.take().deadline );
+                CHECK_EQ( res, std::vector< std::uint64_t >{ 0, 1, 1, 2, 3, 4, 5, 1000 } );
+        }
+
+        SUBCASE( "extreme keys" )
+        {
+                timer t1{ ~std::uint64_t{ 0 } }, t2{ std::uint64_t{ 1 } << 63 }, t3{ 0 };
+                h.link( t1 );
+                h.link( t2 );
+                h.link( t3 );
+                CHECK_EQ( &h.take(), &t3 );
+                CHECK_EQ( &h.take(), &t2 );
+                CHECK_EQ( &h.take(), &t1 );
+                CHECK( h.empty() );
+        }
+}
+
+TEST_CASE( "radix_heap_monotone" )
+{
+        radix_heap< timer, timer::access, deadline_of > h;
+
+        std::vector< timer > ts;
+        ts.reserve( 256 );
+        std::uint64_t seed = 7;
+        auto          rng  = [&] {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                return seed >> 40;
+        };
+
+        std::vector< std::uint64_t > popped;
+        for ( int i = 0; i < 256; i++ ) {
+                ts.emplace_back( h.last_key() + rng() );
+                h.link( ts.back() );
+                if ( i % 3 == 0 )
+                        popped.push_back( h.take().deadline );
+        }
+        while ( !h.empty() )
+                popped.push_back( h.take().deadline );
+
+        CHECK_EQ( popped.size(), ts.size() );
+        CHECK( std::is_sorted( popped.begin(), popped.end() ) );
+}
+
+TEST_CASE( "radix_heap_auto_unlink" )
+{
+        radix_heap< timer > h;
+        timer               t1{ 10 }, t3{ 30 };
+        h.link( t1 );
+        h.link( t3 );
+
+        {
+                timer t2{ 20 };
+                h.link( t2 );
+                CHECK_EQ( h.top(), &t1 );
+        }
+
+        SUBCASE( "destroyed node is not returned" )
+        {
+                CHECK_EQ( &h.take(), &t1 );
+                CHECK_EQ( &h.take(), &t3 );
+                CHECK( h.empty() );
+        }
+
+        SUBCASE( "moved node stays linked" )
+        {
+                timer t4{ std::move( t1 ) };
+                t4.deadline = t1.deadline;
+                CHECK( detached( t1 ) );
+                CHECK_EQ( &h.take(), &t4 );
+                CHECK_EQ( &h.take(), &t3 );
+                CHECK( h.empty() );
+        }
+
+        SUBCASE( "all destroyed" )
+        {
+                {
+                        timer t5{ std::move( t3 ) };
+                        CHECK_EQ( &h.take(), &t1 );
+                }
+                CHECK( h.empty() );
+                CHECK_EQ( h.top(), nullptr );
+        }
+}
+
+TEST_CASE( "radix_heap_move" )
+{
+        timer               t1{ 3 }, t2{ 1 }, t3{ 2 };
+        radix_heap< timer > h1;
+        h1.link( t1 );
+        h1.link( t2 );
+        h1.link( t3 );
+
+        radix_heap< timer > h2{ std::move( h1 ) };
+        CHECK( h1.empty() );
+        CHECK_EQ( &h2.take(), &t2 );
+
+        radix_heap< timer > h3;
+        h3 = std::move( h2 );
+        CHECK( h2.empty() );
+        CHECK_EQ( &h3.take(), &t3 );
+        CHECK_EQ( &h3.take(), &t1 );
+        CHECK( h3.empty() );
+}
+
+}  // namespace zll
@@ -0,0 +1,212 @@
+/// MIT License
+///
+/// Copyright (c) 2026 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "zll.hpp"
+
+#include <doctest/doctest.h>
+#include <utility>
+#include <vector>
+
+namespace zll
+{
+namespace
+{
+
+struct rnode : ll_ring_base< rnode >
+{
+        int value = 0;
+
+        rnode( int v = 0 )
+          : value( v )
+        {
+        }
+};
+
+void check_ring( ll_ring< rnode > const& r, std::vector< rnode const* > const& expected )
+{
+        std::vector< rnode const* > fwd;
+        for ( rnode const& n : r )
+                fwd.push_back( &n );
+        CHECK_EQ( fwd, expected );
+
+        std::vector< rnode const* > bwd;
+        for ( auto it = r.end(); it != r.begin(); )
+                bwd.push_back( &*--it );
+        std::vector< rnode const* > rev( expected.rbegin(), expected.rend() );
+        CHECK_EQ( bwd, rev );
+        CHECK_EQ( r.empty(), expected.empty() );
+}
+
+constinit ll_ring< rnode > static_ring;
+
+struct component : ll_ring_base< component >
+{
+        int id;
+
+        constexpr component( int i )
+          : id( i )
+        {
+        }
+};
+
+/// Ring and its nodes wired together during constant initialization.
+struct registry
+{
+        ll_ring< component > ring;
+        component            a{ 1 }, b{ 2 }, c{ 3 };
+
+        constexpr registry()
+        {
+                ring.link_back( b );
+                ring.link_back( c );
+                ring.link_front( a );
+        }
+};
+
+constinit registry static_registry;
+
+static_assert( [] {
+        registry r;
+        int      ids = 0;
+        for ( component const& c : std::as_const( r ).ring )
+                ids = ids * 10 + c.id;
+        for ( auto it = r.ring.end(); it != r.ring.begin(); )
+                ids = ids * 10 + ( --it )->id;
+        detach( r.b );
+        r.ring.take_back();
+        return ids == 123321 && &r.ring.front() == &r.a && detached( r.c );
+}() );
+
+}  // namespace
+
+TEST_CASE( "ring_link" )
+{
+        rnode            a( 1 ), b( 2 ), c( 3 );
+        ll_ring< rnode > r;
+        check_ring( r, {} );
+
+        r.link_back( a );
+        r.link_back( b );
+        r.link_front( c );
+        check_ring( r, { &c, &a, &b } );
+        CHECK_EQ( &r.front(), &c );
+        CHECK_EQ( &r.back(), &b );
+
+        detach( a );
+        CHECK( detached( a ) );
+        check_ring( r, { &c, &b } );
+
+        r.link_before( r.begin(), a );
+        check_ring( r, { &a, &c, &b } );
+        r.link_before( r.end(), c );
+        check_ring( r, { &a, &b, &c } );
+
+        CHECK_EQ( &r.take_front(), &a );
+        CHECK_EQ( &r.take_back(), &c );
+        check_ring( r, { &b } );
+        CHECK( detached( a ) );
+
+        r.clear();
+        check_ring( r, {} );
+        CHECK( detached( b ) );
+}
+
+TEST_CASE( "ring_node_lifetime" )
+{
+        ll_ring< rnode > r;
+        rnode            a( 1 ), c( 3 );
+        r.link_back( a );
+        {
+                rnode b( 2 );
+                r.link_back( b );
+                r.link_back( c );
+                check_ring( r, { &a, &b, &c } );
+        }
+        check_ring( r, { &a, &c } );
+
+        SUBCASE( "move" )
+        {
+                rnode d{ std::move( a ) };
+                CHECK( detached( a ) );
+                check_ring( r, { &d, &c } );
+
+                rnode e;
+                e = std::move( d );
+                check_ring( r, { &e, &c } );
+        }
+
+        SUBCASE( "copy" )
+        {
+                rnode d{ a };
+                check_ring( r, { &a, &d, &c } );
+
+                rnode e;
+                e = c;
+                check_ring( r, { &a, &d, &c, &e } );
+        }
+
+        SUBCASE( "relink to other ring" )
+        {
+                ll_ring< rnode > r2;
+                r2.link_back( a );
+                check_ring( r, { &c } );
+                check_ring( r2, { &a } );
+        }
+}
+
+TEST_CASE( "ring_move" )
+{
+        rnode            a( 1 ), b( 2 );
+        ll_ring< rnode > r{ &a, &b };
+
+        ll_ring< rnode > r2{ std::move( r ) };
+        check_ring( r, {} );
+        check_ring( r2, { &a, &b } );
+
+        ll_ring< rnode > r3;
+        r3 = std::move( r2 );
+        check_ring( r2, {} );
+        check_ring( r3, { &a, &b } );
+
+        r3 = std::move( r );
+        check_ring( r3, {} );
+        CHECK( !detached( a ) );
+}
+
+TEST_CASE( "ring_constinit" )
+{
+        CHECK( static_ring.empty() );
+        rnode a;
+        static_ring.link_back( a );
+        CHECK_EQ( &static_ring.front(), &a );
+        detach( a );
+        CHECK( static_ring.empty() );
+
+        std::vector< int > ids;
+        for ( component& c : static_registry.ring )
+                ids.push_back( c.id );
+        CHECK_EQ( ids, std::vector< int >{ 1, 2, 3 } );
+        component d{ 4 };
+        static_registry.ring.link_back( d );
+        CHECK_EQ( &static_registry.ring.back(), &d );
+}
+
+}  // namespace zll
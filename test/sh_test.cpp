@@ -22,10 +22,14 @@
 #include "zll.hpp"
 
 #include <doctest/doctest.h>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <ranges>
 #include <set>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace zll
@@ -54,11 +58,13 @@ struct node_t
         }
 
         node_t( node_t&& o ) noexcept
+          : x( o.x )
         {
                 move_from_to< node_t, hdr_access >( o, *this );
         }
 
         node_t( node_t& o ) noexcept
+          : x( o.x )
         {
                 link_detached_to< node_t, hdr_access >( o, *this, std::less<>{} );
         }
@@ -92,7 +98,7 @@ struct der : public sh_base< der >
 {
         int x;
 
-        der( int v = 0 )
+        constexpr der( int v = 0 )
           : x( v )
         {
         }
@@ -103,6 +109,9 @@ struct der : public sh_base< der >
         }
 };
 
+constinit sh_heap< der > static_heap;
+constinit der            static_node;
+
 template < typename T, typename Acc = typename T::access >
 void check_links( T& node )
 {
@@ -378,6 +387,9 @@ TEST_CASE( "merge" )
 
                 h1.merge( std::move( h2 ) );
                 CHECK( h2.empty() );
+                CHECK_EQ( h1.top, &n1 );
+                CHECK_EQ( h1.take().value, 1 );
+                CHECK_EQ( h1.take().value, 2 );
                 CHECK( h1.empty() );
         }
 
@@ -722,5 +734,655 @@ TEST_CASE( "custom_comparator" )
                 check_heap_coherence( h1 );
         }
 }
+
+TEST_CASE( "take_while" )
+{
+        struct timer : sh_base< timer >, ll_base< timer >
+        {
+                using sh_acc = sh_base< timer >::access;
+                using ll_acc = ll_base< timer >::access;
+
+                int deadline;
+
+                timer( int d = 0 )
+                  : deadline( d )
+                {
+                }
+
+                bool operator<( timer const& other ) const noexcept
+                {
+                        return deadline < other.deadline;
+                }
+        };
+        using heap = sh_heap< timer, timer::sh_acc >;
+
+        std::vector< timer > timers;
+        timers.reserve( 64 );
+        for ( int i = 0; i < 64; i++ )
+                timers.emplace_back( ( i * 29 ) % 64 );
+
+        heap h;
+        for ( auto& t : timers )
+                h.link( t );
+
+        SUBCASE( "nothing expired" )
+        {
+                std::size_t calls = 0;
+                CHECK_EQ(
+                    h.take_while(
+                        []( timer& t ) {
+                                return t.deadline < 0;
+                        },
+                        [&]( timer& ) {
+                                ++calls;
+                        } ),
+                    0 );
+                CHECK_EQ( calls, 0 );
+                check_heap_coherence( h );
+        }
+
+        SUBCASE( "callback" )
+        {
+                std::vector< int > taken;
+                auto               n = h.take_while(
+                    []( timer& t ) {
+                            return t.deadline < 20;
+                    },
+                    [&]( timer& t ) {
+                            CHECK( ( detached< timer, timer::sh_acc >( t ) ) );
+                            taken.push_back( t.deadline );
+                    } );
+                CHECK_EQ( n, 20 );
+                std::sort( taken.begin(), taken.end() );
+                std::vector< int > expected;
+                for ( int i = 0; i < 20; i++ )
+                        expected.push_back( i );
+                CHECK_EQ( taken, expected );
+
+                check_heap_coherence( h );
+                check_heap_property< timer, timer::sh_acc >( *h.top );
+                for ( int i = 20; i < 64; i++ )
+                        CHECK_EQ( h.take().deadline, i );
+                CHECK( h.empty() );
+        }
+
+        SUBCASE( "drain_le into list" )
+        {
+                ll_list< timer, timer::ll_acc > out;
+                CHECK_EQ( h.drain_le( timer{ 40 }, out ), 41 );
+                std::size_t count = 0;
+                for ( timer& t : out ) {
+                        CHECK_LE( t.deadline, 40 );
+                        ++count;
+                }
+                CHECK_EQ( count, 41 );
+                check_heap_coherence( h );
+                for ( int i = 41; i < 64; i++ )
+                        CHECK_EQ( h.take().deadline, i );
+        }
+
+        SUBCASE( "everything" )
+        {
+                CHECK_EQ( h.drain_le( timer{ 1000 }, []( timer& ) {} ), 64 );
+                CHECK( h.empty() );
+                for ( auto& t : timers )
+                        CHECK( ( detached< timer, timer::sh_acc >( t ) ) );
+        }
+}
+
+template < typename Stats >
+struct counted_node : sh_base< counted_node< Stats >, std::less<>, Stats >
+{
+        int value = 0;
+
+        counted_node( int v = 0 )
+          : value( v )
+        {
+        }
+
+        bool operator<( counted_node const& other ) const noexcept
+        {
+                return value < other.value;
+        }
+};
+
+TEST_CASE( "stats" )
+{
+        using counted = counted_node< sh_stats >;
+        using heap    = sh_heap< counted, counted::access, std::less<>, sh_stats >;
+
+        static_assert( sizeof( sh_heap< der > ) == sizeof( der* ) );
+        static_assert( sizeof( sh_stats ) == sizeof( std::size_t ) );
+
+
+        std::vector< counted > nodes;
+        nodes.reserve( 32 );
+        for ( int i = 0; i < 32; i++ )
+                nodes.emplace_back( ( i * 7 ) % 32 );
+
+        heap h;
+        CHECK_EQ( h.size(), 0 );
+        for ( auto& n : nodes )
+                h.link( n );
+        CHECK_EQ( h.size(), 32 );
+
+        SUBCASE( "take" )
+        {
+                CHECK_EQ( h.take().value, 0 );
+                h.pop();
+                CHECK_EQ( h.size(), 30 );
+        }
+
+        SUBCASE( "node lifetime" )
+        {
+                {
+                        counted c{ std::move( nodes[5] ) };
+                        CHECK_EQ( h.size(), 32 );
+                        counted d{ c };
+                        CHECK_EQ( h.size(), 33 );
+                        h.detach( c );
+                        CHECK_EQ( h.size(), 32 );
+                        CHECK( ( detached< counted, counted::access >( c ) ) );
+                }
+                CHECK_EQ( h.size(), 31 );
+                nodes[3] = counted{ 100 };
+                CHECK_EQ( h.size(), 30 );
+                nodes[3] = nodes[4];
+                CHECK_EQ( h.size(), 31 );
+                {
+                        counted e{ 7 };
+                        h.link( e );
+                        CHECK_EQ( h.size(), 32 );
+                }
+                CHECK_EQ( h.size(), 31 );
+                h.detach( *h.top );
+                CHECK_EQ( h.size(), 30 );
+                check_heap_property< counted, counted::access >( *h.top );
+        }
+
+        SUBCASE( "copies popped by other heap" )
+        {
+                heap    h2;
+                counted c{ 3 };
+                h2.link( c );
+                counted d{ c };
+                CHECK_EQ( h2.size(), 2 );
+                h2.pop();
+                h2.pop();
+                CHECK( h2.empty() );
+                CHECK_EQ( h2.size(), 0 );
+        }
+
+        SUBCASE( "take_while" )
+        {
+                CHECK_EQ( h.drain_le( counted{ 9 }, []( counted& ) {} ), 10 );
+                CHECK_EQ( h.size(), 22 );
+        }
+
+        SUBCASE( "remove_if" )
+        {
+                CHECK_EQ( h.remove_if(
+                              []( counted& c ) {
+                                      return c.value % 4 == 0;
+                              },
+                              []( counted& ) {} ),
+                          8 );
+                CHECK_EQ( h.size(), 24 );
+        }
+
+        SUBCASE( "merge and move" )
+        {
+                counted c1{ 1 }, c2{ 2 };
+                heap    h2 = { &c1, &c2 };
+                h.merge( std::move( h2 ) );
+                CHECK_EQ( h.size(), 34 );
+                CHECK_EQ( h2.size(), 0 );
+
+                heap h3{ std::move( h ) };
+                CHECK_EQ( h.size(), 0 );
+                CHECK_EQ( h3.size(), 34 );
+        }
+}
+
+TEST_CASE( "debug_stats" )
+{
+        using counted = counted_node< sh_debug_stats >;
+        using heap    = sh_heap< counted, counted::access, std::less<>, sh_debug_stats >;
+
+        std::vector< counted > nodes;
+        nodes.reserve( 32 );
+        for ( int i = 0; i < 32; i++ )
+                nodes.emplace_back( ( i * 7 ) % 32 );
+
+        heap h;
+        for ( auto& n : nodes )
+                h.link( n );
+        CHECK_EQ( h.size(), 32 );
+        CHECK_GT( h.stats.max_merge_steps, 0 );
+        CHECK_GT( h.stats.max_right_spine, 0 );
+        CHECK_LE( h.stats.max_right_spine, h.stats.max_merge_steps );
+
+        h.pop();
+        CHECK_GT( h.stats.last_merge_steps, 0 );
+        CHECK_EQ( h.size(), 31 );
+        nodes.pop_back();
+        CHECK_EQ( h.size(), 30 );
+}
+
+TEST_CASE( "node_flags" )
+{
+        std::vector< der > nodes;
+        for ( int i = 0; i < 16; i++ )
+                nodes.emplace_back( ( i * 7 ) % 16 );
+        for ( std::size_t i = 0; i < nodes.size(); i += 2 )
+                set_node_flags( nodes[i], 1 );
+
+        sh_heap< der > h;
+        for ( auto& n : nodes )
+                h.link( n );
+        check_links( *h.top );
+
+        int last = -1;
+        while ( !h.empty() ) {
+                der& n = h.take();
+                CHECK_LE( last, n.x );
+                last = n.x;
+                CHECK( detached( n ) );
+        }
+        for ( std::size_t i = 0; i < nodes.size(); i++ )
+                CHECK_EQ( node_flags( nodes[i] ), i % 2 == 0 ? 1 : 0 );
+}
+
+TEST_CASE( "constinit" )
+{
+        CHECK( static_heap.empty() );
+        CHECK( detached( static_node ) );
+
+        static_heap.link( static_node );
+        CHECK_EQ( static_heap.top, &static_node );
+
+        static_heap.pop();
+        CHECK( static_heap.empty() );
+        CHECK( detached( static_node ) );
+}
+
+static_assert( std::ranges::forward_range< sh_heap< der > > );
+static_assert( std::ranges::forward_range< sh_heap< der > const > );
+
+TEST_CASE( "ranges" )
+{
+        std::vector< der > nodes;
+        for ( int i = 0; i < 1000; i++ )
+                nodes.emplace_back( ( i * 7919 ) % 1000 );
+        sh_heap< der > h;
+        for ( auto& n : nodes )
+                h.link( n );
+
+        SUBCASE( "iteration visits each node once, top first" )
+        {
+                std::set< der const* > seen;
+                for ( der const& d : std::as_const( h ) )
+                        seen.insert( &d );
+                CHECK_EQ( seen.size(), nodes.size() );
+                CHECK_EQ( &*h.begin(), h.top );
+                CHECK_EQ( std::ranges::distance( h ), 1000 );
+        }
+
+        SUBCASE( "views compose" )
+        {
+                auto even = h | std::views::filter( []( der const& d ) {
+                                    return d.x % 2 == 0;
+                            } ) |
+                            std::views::transform( []( der const& d ) {
+                                    return d.x;
+                            } );
+                std::vector< int > xs( even.begin(), even.end() );
+                std::ranges::sort( xs );
+                CHECK_EQ( xs.size(), 500 );
+                CHECK_EQ( xs.front(), 0 );
+                CHECK_EQ( xs.back(), 998 );
+                CHECK_EQ( std::ranges::count_if( h, []( der const& d ) {
+                                  return d.x < 10;
+                          } ),
+                          10 );
+        }
+
+        SUBCASE( "empty" )
+        {
+                sh_heap< der > e;
+                CHECK( e.begin() == e.end() );
+                CHECK( e.begin() == std::default_sentinel );
+        }
+}
+
+TEST_CASE( "meld_all" )
+{
+        for ( std::size_t k : { 1u, 2u, 5u, 8u } ) {
+                std::vector< der >             nodes;
+                std::vector< sh_heap< der > >  heaps( k );
+                std::vector< sh_heap< der >* > ptrs;
+                for ( std::size_t i = 0; i < k * 50; i++ )
+                        nodes.emplace_back( static_cast< int >( ( i * 7919 ) % 997 ) );
+                for ( std::size_t i = 0; i < nodes.size(); i++ )
+                        heaps[i % k].link( nodes[i] );
+                heaps.emplace_back();
+                for ( auto& h : heaps )
+                        ptrs.push_back( &h );
+
+                auto& res = meld_all( std::span{ ptrs } );
+                CHECK_EQ( &res, &heaps[0] );
+                for ( std::size_t i = 1; i < heaps.size(); i++ )
+                        CHECK( heaps[i].empty() );
+                check_links( *res.top );
+
+                std::vector< int > out;
+                while ( !res.empty() )
+                        out.push_back( res.take().x );
+                CHECK_EQ( out.size(), nodes.size() );
+                CHECK( std::is_sorted( out.begin(), out.end() ) );
+        }
+}
+
+template < typename T, typename Acc = typename T::access >
+void rec_inorder( T& n, std::vector< T* >& out )
+{
+        auto& h = Acc::get( n );
+        if ( h.left )
+                rec_inorder( *h.left, out );
+        out.push_back( &n );
+        if ( h.right )
+                rec_inorder( *h.right, out );
+}
+
+template < typename T, typename Acc = typename T::access >
+void rec_preorder( T& n, std::vector< T* >& out )
+{
+        auto& h = Acc::get( n );
+        out.push_back( &n );
+        if ( h.left )
+                rec_preorder( *h.left, out );
+        if ( h.right )
+                rec_preorder( *h.right, out );
+}
+
+template < typename T, typename Acc = typename T::access >
+void rec_postorder( T& n, std::vector< T* >& out )
+{
+        auto& h = Acc::get( n );
+        if ( h.left )
+                rec_postorder( *h.left, out );
+        if ( h.right )
+                rec_postorder( *h.right, out );
+        out.push_back( &n );
+}
+
+TEST_CASE( "traversal_order" )
+{
+        std::vector< der > nodes;
+        for ( int i = 0; i < 500; i++ )
+                nodes.emplace_back( ( i * 7919 ) % 503 );
+        sh_heap< der > h;
+        for ( auto& n : nodes )
+                h.link( n );
+
+        auto check = [&]( auto&& rec, auto&& iter ) {
+                // every subtree is walked without escaping to its ancestors
+                for ( der& n : h ) {
+                        std::vector< der* > expected, got;
+                        rec( n, expected );
+                        iter( n, [&]( der& m ) {
+                                got.push_back( &m );
+                        } );
+                        CHECK_EQ( got, expected );
+                }
+        };
+        check(
+            []( der& n, auto& out ) {
+                    rec_inorder( n, out );
+            },
+            []( der& n, auto f ) {
+                    inorder_traverse( n, f );
+            } );
+        check(
+            []( der& n, auto& out ) {
+                    rec_preorder( n, out );
+            },
+            []( der& n, auto f ) {
+                    preorder_traverse( n, f );
+            } );
+        check(
+            []( der& n, auto& out ) {
+                    rec_postorder( n, out );
+            },
+            []( der& n, auto f ) {
+                    postorder_traverse( n, f );
+            } );
+}
+
+TEST_CASE( "traversal_deep" )
+{
+        // descending keys make each new node the top with the old heap as its only child
+        std::size_t const  n = 200000;
+        std::vector< der > nodes;
+        nodes.reserve( n );
+        for ( std::size_t i = 0; i < n; i++ )
+                nodes.emplace_back( static_cast< int >( n - i ) );
+        sh_heap< der > h;
+        for ( auto& d : nodes )
+                h.link( d );
+
+        std::size_t depth = 0;
+        for ( der* c = h.top; c; c = der::access::get( *c ).left ? der::access::get( *c ).left :
+                                                                   der::access::get( *c ).right )
+                depth++;
+        CHECK_GT( depth, n / 2 );
+
+        std::size_t in = 0, pre = 0, post = 0;
+        inorder_traverse( *h.top, [&]( der& ) {
+                in++;
+        } );
+        preorder_traverse( *h.top, [&]( der& ) {
+                pre++;
+        } );
+        // post-order allows the visited node to be detached
+        postorder_traverse( *h.top, [&]( der& d ) {
+                post++;
+                if ( &d != h.top )
+                        detach( d, std::less<>{} );
+        } );
+        CHECK_EQ( in, n );
+        CHECK_EQ( pre, n );
+        CHECK_EQ( post, n );
+}
+
+TEST_CASE( "peek_sorted" )
+{
+        std::vector< der > nodes;
+        for ( int i = 0; i < 1000; i++ )
+                nodes.emplace_back( ( i * 7919 ) % 1009 );
+        std::vector< int > sorted;
+        for ( auto& n : nodes )
+                sorted.push_back( n.x );
+        std::ranges::sort( sorted );
+
+        sh_heap< der > h;
+        for ( auto& n : nodes )
+                h.link( n );
+
+        for ( std::size_t k : { 1u, 2u, 7u, 64u, 1000u } ) {
+                std::vector< der const* > buf( k );
+                std::vector< int >        got;
+                auto collect = [&]( der const& d ) {
+                        got.push_back( d.x );
+                };
+                auto cnt = h.peek_sorted( std::span{ buf }, collect );
+                CHECK_EQ( cnt, k );
+                CHECK( std::equal( got.begin(), got.end(), sorted.begin() ) );
+        }
+
+        std::vector< int > got;
+        CHECK_EQ( h.peek_sorted< 16 >( [&]( der const& d ) {
+                got.push_back( d.x );
+        } ),
+                  16 );
+        CHECK( std::equal( got.begin(), got.end(), sorted.begin() ) );
+
+        // heap is left intact
+        check_links( *h.top );
+        std::vector< int > out;
+        while ( !h.empty() )
+                out.push_back( h.take().x );
+        CHECK_EQ( out, sorted );
+
+        SUBCASE( "fewer nodes than k" )
+        {
+                der            a{ 3 }, b{ 1 };
+                sh_heap< der > s = { &a, &b };
+                got.clear();
+                CHECK_EQ( s.peek_sorted< 8 >( [&]( der const& d ) {
+                        got.push_back( d.x );
+                } ),
+                          2 );
+                CHECK_EQ( got, std::vector< int >{ 1, 3 } );
+                CHECK_EQ( std::as_const( s ).peek_sorted< 0 >( [&]( der const& ) {} ), 0 );
+
+                sh_heap< der > e;
+                CHECK_EQ( e.peek_sorted< 4 >( [&]( der const& ) {} ), 0 );
+        }
+}
+
+TEST_CASE( "remove_if" )
+{
+        struct timer : sh_base< timer >, ll_base< timer >
+        {
+                using sh_acc = sh_base< timer >::access;
+                using ll_acc = ll_base< timer >::access;
+
+                int deadline;
+                int group;
+
+                timer( int d = 0, int g = 0 )
+                  : deadline( d )
+                  , group( g )
+                {
+                }
+
+                bool operator<( timer const& other ) const noexcept
+                {
+                        return deadline < other.deadline;
+                }
+        };
+        using heap = sh_heap< timer, timer::sh_acc >;
+
+        std::vector< timer > timers;
+        timers.reserve( 1000 );
+        for ( int i = 0; i < 1000; i++ )
+                timers.emplace_back( ( i * 7919 ) % 1000, i % 3 );
+
+        heap h;
+        for ( auto& t : timers )
+                h.link( t );
+
+        auto check_rest = [&]( auto&& keep ) {
+                std::vector< int > expected;
+                for ( auto& t : timers )
+                        if ( keep( t ) )
+                                expected.push_back( t.deadline );
+                std::ranges::sort( expected );
+                if ( h.top ) {
+                        check_heap_coherence( h );
+                        check_heap_property< timer, timer::sh_acc >( *h.top );
+                }
+                std::vector< int > out;
+                while ( !h.empty() )
+                        out.push_back( h.take().deadline );
+                CHECK_EQ( out, expected );
+        };
+
+        SUBCASE( "group" )
+        {
+                std::size_t calls = 0;
+                auto        n     = h.remove_if(
+                    []( timer& t ) {
+                            return t.group == 1;
+                    },
+                    [&]( timer& t ) {
+                            CHECK( ( detached< timer, timer::sh_acc >( t ) ) );
+                            CHECK_EQ( t.group, 1 );
+                            ++calls;
+                    } );
+                CHECK_EQ( n, 333 );
+                CHECK_EQ( calls, 333 );
+                check_rest( []( timer& t ) {
+                        return t.group != 1;
+                } );
+        }
+
+        SUBCASE( "into list" )
+        {
+                ll_list< timer, timer::ll_acc > out;
+                CHECK_EQ( h.remove_if(
+                              []( timer& t ) {
+                                      return t.deadline % 2 == 0;
+                              },
+                              out ),
+                          500 );
+                for ( timer& t : out )
+                        CHECK_EQ( t.deadline % 2, 0 );
+                check_rest( []( timer& t ) {
+                        return t.deadline % 2 != 0;
+                } );
+        }
+
+        SUBCASE( "nothing" )
+        {
+                CHECK_EQ( h.remove_if(
+                              []( timer& ) {
+                                      return false;
+                              },
+                              []( timer& ) {} ),
+                          0 );
+                check_rest( []( timer& ) {
+                        return true;
+                } );
+        }
+
+        SUBCASE( "everything" )
+        {
+                CHECK_EQ( h.remove_if(
+                              []( timer& ) {
+                                      return true;
+                              },
+                              []( timer& ) {} ),
+                          1000 );
+                CHECK( h.empty() );
+                for ( auto& t : timers )
+                        CHECK( ( detached< timer, timer::sh_acc >( t ) ) );
+        }
+
+        SUBCASE( "deep heap" )
+        {
+                std::vector< timer > chain;
+                chain.reserve( 200000 );
+                for ( int i = 0; i < 200000; i++ )
+                        chain.emplace_back( 200000 - i, i % 2 );
+                heap d;
+                for ( auto& t : chain )
+                        d.link( t );
+                CHECK_EQ( d.remove_if(
+                              []( timer& t ) {
+                                      return t.group == 0;
+                              },
+                              []( timer& ) {} ),
+                          100000 );
+                int prev = 0;
+                while ( !d.empty() ) {
+                        timer& t = d.take();
+                        CHECK_EQ( t.group, 1 );
+                        CHECK_LT( prev, t.deadline );
+                        prev = t.deadline;
+                }
+        }
+}
 }  // namespace
 }  // namespace zll